@@ -96,6 +96,30 @@ void testLFU() {
 	assert(result8.value() == 1);
 }
 
+// 按哈希路由时 key 只存在于归属线程，无论传入哪个 index，写入后立即可见，不需要等待同步
+template<typename CacheType>
+void testHashAffinity() {
+	CacheType cache(10, 2, 3, Cache::RouteMode::HashAffinity);
+
+	cache.put("one", 1, 0);
+	cache.put("two", 2, 1);
+
+	for (size_t index = 0; index < 2; ++index) {
+		std::optional<int> one = cache.get("one", index);
+		assert(one != std::nullopt);
+		assert(one.value() == 1);
+
+		std::optional<int> two = cache.get("two", index);
+		assert(two != std::nullopt);
+		assert(two.value() == 2);
+	}
+
+	cache.put("three", 3);
+	std::optional<int> three = cache.get("three");
+	assert(three != std::nullopt);
+	assert(three.value() == 3);
+}
+
 using namespace std;
 
 int main() {
@@ -104,5 +128,9 @@ int main() {
 
 	testLFU();
 
+	testHashAffinity<LRUCache<std::string, int>>();
+
+	testHashAffinity<LFUCache<std::string, int>>();
+
 	return 0;
 }
\ No newline at end of file
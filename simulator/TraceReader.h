@@ -0,0 +1,310 @@
+/**
+  ******************************************************************************
+  * @file           : TraceReader.h
+  * @author         : xy
+  * @brief          : 以 mmap 方式读取访问 trace，解析为 64 位 key 序列
+  * @attention      : 二进制格式直接使用映射的内存，不拷贝；文本格式解析一次后由所有回放线程只读共享
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SIMULATOR_TRACEREADER_H_
+#define CACHE_SIMULATOR_TRACEREADER_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Cache {
+
+/**
+ * @brief trace 文件格式
+ * kBinary64 / kBinary32：连续的小端 uint64_t / uint32_t key，没有分隔符
+ * kCsv：每行一次访问，key 取指定列（从 0 开始），整数直接作为 key，其他内容取哈希
+ * kArc：ARC 论文公开的 trace（包括 OLTP、P1 ~ P14、DS1、S1 ~ S3），每行
+ *       “起始块号 块数 忽略 请求号”，展开为块数次连续块号的访问
+ * kSpc：UMass 公开的 SPC 格式 OLTP trace（Financial1/2、WebSearch1 ~ 3），每行
+ *       “ASU,LBA,字节数,操作,时间戳”，key 由 ASU 与 LBA 组成，每行一次访问
+ */
+enum class TraceFormat {
+  kBinary64,
+  kBinary32,
+  kCsv,
+  kArc,
+  kSpc
+};
+
+/**
+ * @brief 只读映射整个文件，析构时解除映射
+ */
+class MappedFile {
+ public:
+  MappedFile() : data_(nullptr), size_(0) {}
+
+  ~MappedFile() {
+	  if (data_ != nullptr) {
+		  munmap(data_, size_);
+	  }
+  }
+
+  // 失败时返回 false，错误信息见 error()
+  bool open(const std::string &path) {
+	  int fd = ::open(path.c_str(), O_RDONLY);
+	  if (fd < 0) {
+		  error_ = path + ": " + std::strerror(errno);
+		  return false;
+	  }
+	  struct stat st{};
+	  if (fstat(fd, &st) != 0) {
+		  error_ = path + ": " + std::strerror(errno);
+		  ::close(fd);
+		  return false;
+	  }
+	  size_ = static_cast<size_t>(st.st_size);
+	  if (size_ > 0) {
+		  void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+		  if (data == MAP_FAILED) {
+			  error_ = path + ": " + std::strerror(errno);
+			  size_ = 0;
+			  ::close(fd);
+			  return false;
+		  }
+		  data_ = data;
+		  // 解析与回放都是顺序读
+		  madvise(data_, size_, MADV_SEQUENTIAL);
+	  }
+	  // 映射建立后即可关闭文件
+	  ::close(fd);
+	  return true;
+  }
+
+  const char *data() const { return static_cast<const char *>(data_); }
+
+  size_t size() const { return size_; }
+
+  const std::string &error() const { return error_; }
+
+ private:
+  void *data_;            // 映射的起始地址
+  size_t size_;            // 文件字节数
+  std::string error_;    // 最近一次失败的原因
+
+ public:
+// 删除拷贝语义
+  MappedFile(const MappedFile &other) = delete;
+  MappedFile &operator=(const MappedFile &other) = delete;
+};
+
+/**
+ * @brief 访问 trace：按格式把映射的文件解析为 key 序列。
+ * kBinary64 在小端机器上直接指向映射的内存，其余格式解析到 keys_ 中
+ */
+class Trace {
+ public:
+  Trace() : data_(nullptr), size_(0) {}
+
+  ~Trace() = default;
+
+  // column 与 skipHeader 只对 kCsv 有效；失败时返回 false，错误信息见 error()
+  bool load(const std::string &path, TraceFormat format, size_t column = 0, bool skipHeader = false) {
+	  if (!file_.open(path)) {
+		  error_ = file_.error();
+		  return false;
+	  }
+	  std::string_view text(file_.data(), file_.size());
+	  switch (format) {
+		  case TraceFormat::kBinary64:
+			  if (text.size() % sizeof(uint64_t) != 0) {
+				  error_ = path + ": 文件长度不是 8 的整数倍";
+				  return false;
+			  }
+			  // mmap 的地址按页对齐，可以直接当作 uint64_t 数组
+			  data_ = reinterpret_cast<const uint64_t *>(file_.data());
+			  size_ = text.size() / sizeof(uint64_t);
+			  return true;
+		  case TraceFormat::kBinary32:
+			  if (text.size() % sizeof(uint32_t) != 0) {
+				  error_ = path + ": 文件长度不是 4 的整数倍";
+				  return false;
+			  }
+			  keys_.resize(text.size() / sizeof(uint32_t));
+			  for (size_t i = 0; i < keys_.size(); ++i) {
+				  uint32_t key;
+				  std::memcpy(&key, text.data() + i * sizeof(uint32_t), sizeof(uint32_t));
+				  keys_[i] = key;
+			  }
+			  break;
+		  case TraceFormat::kCsv:
+			  if (!parseLines(text, skipHeader, [&](std::string_view line) { return parseCsv(line, column); })) {
+				  return false;
+			  }
+			  break;
+		  case TraceFormat::kArc:
+			  if (!parseLines(text, false, [&](std::string_view line) { return parseArc(line); })) {
+				  return false;
+			  }
+			  break;
+		  case TraceFormat::kSpc:
+			  if (!parseLines(text, false, [&](std::string_view line) { return parseSpc(line); })) {
+				  return false;
+			  }
+			  break;
+	  }
+	  data_ = keys_.data();
+	  size_ = keys_.size();
+	  return true;
+  }
+
+  const uint64_t *data() const { return data_; }
+
+  size_t size() const { return size_; }
+
+  const std::string &error() const { return error_; }
+
+ private:
+  // 逐行解析，跳过空行；parse 返回 false 时报告行号
+  template<typename Parse>
+  bool parseLines(std::string_view text, bool skipHeader, Parse parse) {
+	  size_t lineNo = 0;
+	  while (!text.empty()) {
+		  auto end = text.find('\n');
+		  auto line = text.substr(0, end);
+		  text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+		  ++lineNo;
+		  if (!line.empty() && line.back() == '\r') {
+			  line.remove_suffix(1);
+		  }
+		  if (line.empty() || (skipHeader && lineNo == 1)) {
+			  continue;
+		  }
+		  if (!parse(line)) {
+			  error_ = "第 " + std::to_string(lineNo) + " 行无法解析: " + std::string(line.substr(0, 80));
+			  return false;
+		  }
+	  }
+	  return true;
+  }
+
+  bool parseCsv(std::string_view line, size_t column) {
+	  auto field = split(line, ',', column);
+	  if (!field) {
+		  return false;
+	  }
+	  auto text = trim(*field);
+	  if (!text.empty() && text.front() == '"' && text.back() == '"' && text.size() >= 2) {
+		  text = text.substr(1, text.size() - 2);
+	  }
+	  uint64_t key;
+	  keys_.push_back(toNumber(text, key) ? key : fnv1a(text));
+	  return true;
+  }
+
+  bool parseArc(std::string_view line) {
+	  uint64_t start, count;
+	  auto first = splitSpace(line, 0);
+	  auto second = splitSpace(line, 1);
+	  if (!first || !second || !toNumber(*first, start) || !toNumber(*second, count)) {
+		  return false;
+	  }
+	  count = std::max<uint64_t>(count, 1);
+	  for (uint64_t block = 0; block < count; ++block) {
+		  keys_.push_back(start + block);
+	  }
+	  return true;
+  }
+
+  bool parseSpc(std::string_view line) {
+	  uint64_t asu, lba;
+	  auto first = split(line, ',', 0);
+	  auto second = split(line, ',', 1);
+	  if (!first || !second || !toNumber(trim(*first), asu) || !toNumber(trim(*second), lba)) {
+		  return false;
+	  }
+	  // LBA 不会超过 48 位，高 16 位放 ASU
+	  keys_.push_back((asu << 48) ^ lba);
+	  return true;
+  }
+
+  // 第 index 个以 sep 分隔的字段
+  static std::optional<std::string_view> split(std::string_view line, char sep, size_t index) {
+	  for (size_t i = 0; i < index; ++i) {
+		  auto pos = line.find(sep);
+		  if (pos == std::string_view::npos) {
+			  return std::nullopt;
+		  }
+		  line.remove_prefix(pos + 1);
+	  }
+	  return line.substr(0, line.find(sep));
+  }
+
+  // 第 index 个以空白分隔的字段
+  static std::optional<std::string_view> splitSpace(std::string_view line, size_t index) {
+	  constexpr const char *kSpaces = " \t";
+	  for (size_t i = 0;; ++i) {
+		  auto begin = line.find_first_not_of(kSpaces);
+		  if (begin == std::string_view::npos) {
+			  return std::nullopt;
+		  }
+		  line.remove_prefix(begin);
+		  auto end = line.find_first_of(kSpaces);
+		  if (i == index) {
+			  return line.substr(0, end);
+		  }
+		  if (end == std::string_view::npos) {
+			  return std::nullopt;
+		  }
+		  line.remove_prefix(end);
+	  }
+  }
+
+  static std::string_view trim(std::string_view text) {
+	  while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+		  text.remove_prefix(1);
+	  }
+	  while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+		  text.remove_suffix(1);
+	  }
+	  return text;
+  }
+
+  // 整个字段都是十进制整数时返回 true
+  static bool toNumber(std::string_view text, uint64_t &value) {
+	  auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+	  return ec == std::errc() && ptr == text.data() + text.size() && !text.empty();
+  }
+
+  static uint64_t fnv1a(std::string_view text) {
+	  uint64_t hash = 0xcbf29ce484222325ULL;
+	  for (unsigned char c : text) {
+		  hash = (hash ^ c) * 0x100000001b3ULL;
+	  }
+	  return hash;
+  }
+
+ private:
+  MappedFile file_;                // 映射的 trace 文件
+  std::vector<uint64_t> keys_;    // 文本格式解析出的 key
+  const uint64_t *data_;        // key 序列
+  size_t size_;                    // key 个数
+  std::string error_;            // 最近一次失败的原因
+
+ public:
+// 删除拷贝语义
+  Trace(const Trace &other) = delete;
+  Trace &operator=(const Trace &other) = delete;
+};
+
+}
+
+#endif //CACHE_SIMULATOR_TRACEREADER_H_
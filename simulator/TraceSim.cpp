@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LRU.h"
+#include "LFU.h"
+#include "ArcCache.h"
+#include "ClockLRU.h"
+#include "TinyLFU.h"
+#include "Sieve.h"
+#include "S3FIFO.h"
+#include "SLRU.h"
+#include "TwoQ.h"
+#include "LIRS.h"
+#include "TraceReader.h"
+
+using namespace std;
+using namespace Cache;
+
+// 回放只关心命中与否，值用 4 字节整数，避免每次 put 构造字符串
+using Policy = CachePolicy<uint64_t, uint32_t>;
+
+const std::vector<std::string> kPolicies = {"LRU", "LFU", "LRU-2", "ARC", "CLOCK", "TinyLFU",
+											"SIEVE", "S3-FIFO", "SLRU", "2Q", "LIRS"};
+
+// 按名字创建淘汰策略，名字与 BaseCacheTest 的输出一致，未知名字返回 nullptr
+std::unique_ptr<Policy> makePolicy(const std::string &name, size_t capacity) {
+	if (name == "LRU") return std::make_unique<LRU<uint64_t, uint32_t>>(capacity);
+	if (name == "LFU") return std::make_unique<LFU<uint64_t, uint32_t>>(capacity);
+	if (name == "LRU-2") return std::make_unique<KLru<uint64_t, uint32_t>>(capacity, 2);
+	if (name == "ARC") return std::make_unique<ArcCache<uint64_t, uint32_t>>(capacity, 2);
+	if (name == "CLOCK") return std::make_unique<ClockLRU<uint64_t, uint32_t>>(capacity);
+	if (name == "TinyLFU") return std::make_unique<TinyLFU<uint64_t, uint32_t>>(capacity);
+	if (name == "SIEVE") return std::make_unique<Sieve<uint64_t, uint32_t>>(capacity);
+	if (name == "S3-FIFO") return std::make_unique<S3FIFO<uint64_t, uint32_t>>(capacity);
+	if (name == "SLRU") return std::make_unique<SLRU<uint64_t, uint32_t>>(capacity);
+	if (name == "2Q") return std::make_unique<TwoQ<uint64_t, uint32_t>>(capacity);
+	if (name == "LIRS") return std::make_unique<LIRS<uint64_t, uint32_t>>(capacity);
+	return nullptr;
+}
+
+struct Config {
+	std::string policy;
+	size_t capacity;
+};
+
+struct Result {
+	uint64_t misses = 0;
+	double seconds = 0;
+};
+
+// 未命中时写入，与 BaseCacheTest 的扫描干扰测试相同；只统计回放耗时，不含构造与析构
+Result replay(const Config &config, const Trace &trace) {
+	auto cache = makePolicy(config.policy, config.capacity);
+	Result result;
+	auto keys = trace.data();
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < trace.size(); ++i) {
+		auto key = keys[i];
+		if (cache->get(key) == std::nullopt) {
+			result.misses++;
+			cache->put(key, static_cast<uint32_t>(key));
+		}
+	}
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+std::vector<std::string> splitList(const std::string &text) {
+	std::vector<std::string> items;
+	std::stringstream ss(text);
+	std::string item;
+	while (std::getline(ss, item, ',')) {
+		if (!item.empty()) {
+			items.push_back(item);
+		}
+	}
+	return items;
+}
+
+void usage(const char *name) {
+	std::cerr << "用法: " << name << " [选项] <trace 文件>\n"
+			  << "  -f <格式>    bin（uint64，默认）| bin32 | csv | arc | spc\n"
+			  << "  -p <策略>    逗号分隔，默认全部：";
+	for (size_t i = 0; i < kPolicies.size(); ++i) {
+		std::cerr << (i ? "," : "") << kPolicies[i];
+	}
+	std::cerr << "\n"
+			  << "  -c <容量>    逗号分隔的条目数，默认 1000,10000,100000\n"
+			  << "  -j <线程数>  同时回放的配置数，默认为 CPU 核数\n"
+			  << "  --column <n> csv 中 key 所在列，从 0 开始，默认 0\n"
+			  << "  --header     csv 第一行是表头，跳过\n";
+}
+
+int main(int argc, char *argv[]) {
+	std::string path, format = "bin";
+	std::vector<std::string> policies = kPolicies;
+	std::vector<size_t> capacities = {1000, 10000, 100000};
+	size_t jobs = std::max(1u, std::thread::hardware_concurrency());
+	size_t column = 0;
+	bool header = false;
+
+	try {
+		for (int i = 1; i < argc; ++i) {
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+			if (arg == "-f" && hasValue) {
+				format = argv[++i];
+			} else if (arg == "-p" && hasValue) {
+				policies = splitList(argv[++i]);
+			} else if (arg == "-c" && hasValue) {
+				capacities.clear();
+				for (auto &item : splitList(argv[++i])) {
+					capacities.push_back(std::stoull(item));
+				}
+			} else if (arg == "-j" && hasValue) {
+				jobs = std::max<size_t>(1, std::stoull(argv[++i]));
+			} else if (arg == "--column" && hasValue) {
+				column = std::stoull(argv[++i]);
+			} else if (arg == "--header") {
+				header = true;
+			} else if (arg[0] != '-' && path.empty()) {
+				path = arg;
+			} else {
+				usage(argv[0]);
+				return 1;
+			}
+		}
+	} catch (const std::exception &) {
+		// 容量、线程数、列号不是整数
+		usage(argv[0]);
+		return 1;
+	}
+	if (path.empty() || policies.empty() || capacities.empty()) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	TraceFormat traceFormat;
+	if (format == "bin") traceFormat = TraceFormat::kBinary64;
+	else if (format == "bin32") traceFormat = TraceFormat::kBinary32;
+	else if (format == "csv") traceFormat = TraceFormat::kCsv;
+	else if (format == "arc") traceFormat = TraceFormat::kArc;
+	else if (format == "spc") traceFormat = TraceFormat::kSpc;
+	else {
+		std::cerr << "未知的 trace 格式: " << format << std::endl;
+		return 1;
+	}
+	for (auto &name : policies) {
+		if (makePolicy(name, 1) == nullptr) {
+			std::cerr << "未知的策略: " << name << std::endl;
+			return 1;
+		}
+	}
+
+	Trace trace;
+	auto loadStart = std::chrono::steady_clock::now();
+	if (!trace.load(path, traceFormat, column, header)) {
+		std::cerr << trace.error() << std::endl;
+		return 1;
+	}
+	double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loadStart).count();
+	std::cout << "trace: " << path << " | 访问次数: " << trace.size() << " | 加载耗时: " << loadSeconds << " 秒" << std::endl;
+	if (trace.size() == 0) {
+		return 0;
+	}
+
+	// 每个（策略，容量）组合由一个线程独立回放，共享只读的 trace；
+	// 同时运行的线程不超过 jobs，避免线程数超过核数时吞吐量互相干扰
+	std::vector<Config> configs;
+	for (auto capacity : capacities) {
+		for (auto &name : policies) {
+			configs.push_back({name, capacity});
+		}
+	}
+	std::vector<Result> results(configs.size());
+	std::atomic<size_t> next{0};
+	std::vector<std::thread> workers;
+	for (size_t t = 0; t < std::min(jobs, configs.size()); ++t) {
+		workers.emplace_back([&]() {
+			for (size_t i = next.fetch_add(1); i < configs.size(); i = next.fetch_add(1)) {
+				results[i] = replay(configs[i], trace);
+			}
+		});
+	}
+	for (auto &worker : workers) {
+		worker.join();
+	}
+
+	// 表头中每个汉字占 3 字节、显示 2 列，setw 按字节计数，因此多留出汉字个数的宽度
+	std::cout << std::left << std::setw(10) << "策略" << std::right << std::setw(14) << "容量"
+			  << std::setw(15) << "缺失率" << std::setw(19) << "吞吐量(Mops/s)" << std::endl;
+	for (size_t i = 0; i < configs.size(); ++i) {
+		double missRatio = 100.0 * results[i].misses / trace.size();
+		double mops = trace.size() / results[i].seconds / 1e6;
+		std::cout << std::left << std::setw(8) << configs[i].policy << std::right << std::setw(12) << configs[i].capacity
+				  << std::fixed << std::setprecision(2) << std::setw(11) << missRatio << "%"
+				  << std::setw(16) << mops << std::endl;
+	}
+	return 0;
+}
@@ -11,72 +11,360 @@
 #ifndef CACHE_SRC_ARCCACHE_ARCCACHE_H_
 #define CACHE_SRC_ARCCACHE_ARCCACHE_H_
 
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <optional>
+#include <variant>
+
 #include "CachePolicy.h"
-#include "ArcLFU.h"
-#include "ArcLRU.h"
+#include "CacheWeigher.h"
+#include "FlatMap.h"
+#include "TimingWheel.h"
 
 namespace Cache{
-template<typename Key, typename Value>
+/**
+ * @brief capacity 为整个缓存的容量（权重之和的上限），默认每个条目权重为 1。
+ * 只访问过一次的条目在 LRU 部分（T1），命中 transformThreshold - 1 次后转移到 LFU 部分（T2），两部分合计不超过 capacity。
+ * 两部分各有一个只保存 key 的淘汰链表（B1、B2），按 ARC 的规则自适应 T1 的目标大小 p：
+ * 写入的 key 命中 B1 说明 T1 太小，p 增加 max(|B2| / |B1|, 1) 倍的条目权重；命中 B2 则按对称的比例减小。
+ * 需要腾出空间时，T1 超过 p 就从 T1 淘汰，否则从 T2 淘汰；T1 与 B1 合计不超过 capacity，四者合计不超过 2 * capacity。
+ * 四个链表共用一个索引，索引的值指向主缓存的条目或淘汰链表的节点，每次 get、put 只查一次哈希表；
+ * 淘汰链表的节点只有 key、权重和所在链表，条目进入淘汰链表时整个释放，value、定时器挂钩与频率桶都不保留，
+ * 在 T1、T2 之间移动仍是 splice。条目与淘汰链表节点互换时要再查一次索引改写它指向的位置。
+ * 设置了过期时间的条目挂在时间轮上（链表节点地址在 splice 时不变），过期后直接删除，不进入淘汰链表
+ * @tparam Key
+ * @tparam Value
+ * @tparam Weigher 形如 size_t(const Key &, const Value &)
+ */
+template<typename Key, typename Value, typename Weigher = UnitWeigher<Key, Value>>
 class ArcCache : public CachePolicy<Key,Value>{
+  enum Where : uint8_t {
+	kT1,    // LRU 部分
+	kT2,    // LFU 部分
+	kB1,    // LRU 部分的淘汰链表
+	kB2        // LFU 部分的淘汰链表
+  };
+
+  struct Bucket;
+  using BucketList = std::list<Bucket>;
+  using BucketIt = typename BucketList::iterator;
+
+  // 继承 TimerHook，设置过期时间的条目直接挂到时间轮上
+  struct Entry : TimerHook {
+	  Key key_;
+	  Value value_;
+	  size_t weight_;
+	  size_t count_;                // T1 中的访问次数，T2 中的频率
+	  Where where_;                    // kT1 或 kT2
+	  BucketIt bucket_;                // 位于 T2 时所在的频率桶
+  };
+  using EntryList = std::list<Entry>;
+  using EntryIt = typename EntryList::iterator;
+
+  // 淘汰链表的节点，只保留 key 与权重
+  struct Ghost {
+	  Key key_;
+	  size_t weight_;
+	  Where where_;                    // kB1 或 kB2
+  };
+  using GhostList = std::list<Ghost>;
+  using GhostIt = typename GhostList::iterator;
+
+  // 索引的值：位于主缓存时指向条目，位于淘汰链表时指向淘汰链表的节点
+  using Slot = std::variant<EntryIt, GhostIt>;
+
+  // T2 的频率桶，按频率升序排列，桶内头部最久未访问，与 BucketLFU 相同
+  struct Bucket {
+	  size_t freq_;
+	  EntryList entries_;
+  };
+
  public:
-  explicit ArcCache(size_t capacity, size_t transformThreshold)
+  using NodeMap = FlatMap<Key, Slot>;
+
+  explicit ArcCache(size_t capacity, size_t transformThreshold, Weigher weigher = Weigher())
 	  : capacity_(capacity)
 		, transformThreshold_(transformThreshold)
-		, arcLRU(std::make_unique<ArcLRU<Key, Value>>(capacity, transformThreshold))
-		, arcLFU(std::make_unique<ArcLFU<Key, Value>>
-					 (capacity, transformThreshold)) {
+		, target_(0)
+		, weigher_(std::move(weigher)) {
 
   }
 
-  void put(Key key, Value value) {
-	  if (arcLRU->checkEliminate(key)) {
-		  if (arcLFU->decreaseCapacity()) {
-			  arcLRU->increaseCapacity();
-		  }
-		  arcLRU->delEliminateNode(key);
-		  arcLFU->put(key, value);
-	  } else if (arcLFU->checkEliminate(key)) {
-		  if (arcLRU->decreaseCapacity()) {
-			  arcLFU->increaseCapacity();
+  // 不带过期时间的写入，已有的过期时间会被清除
+  void put(Key key, Value value) override {
+	  tick();
+	  if (auto entry = insert(std::move(key), std::move(value))) {
+		  wheel_.cancel(entry);
+	  }
+  }
+
+  // 写入后经过 ttl 过期，过期的条目不会再被读到，由之后的写入及按采样节奏的未命中读取回收
+  void put(Key key, Value value, std::chrono::nanoseconds ttl) {
+	  tick();
+	  if (auto entry = insert(std::move(key), std::move(value))) {
+		  wheel_.schedule(entry, ttl);
+	  }
+  }
+
+  std::optional<Value> get(const Key &key) override {
+	  auto it = index_.find(key);
+	  auto slot = it == index_.end() ? nullptr : std::get_if<EntryIt>(&it->second);
+	  if (slot == nullptr) {
+		  tick(true);
+		  return std::nullopt;
+	  }
+	  auto entry = *slot;
+	  // 命中不推进时间轮：没有过期时间的条目只判断一次，设置了过期时间的条目才按时钟判断，
+	  // 已过期但还没轮到回收的按未命中处理，顺便回收
+	  if (entry->scheduled() && entry->expired(wheel_.current())) {
+		  removeEntry(entry);
+		  index_.erase(it);
+		  return std::nullopt;
+	  }
+	  touch(entry);
+	  return entry->value_;
+  }
+
+  // LRU、LFU 两部分主缓存的权重之和
+  size_t totalWeight() const { return weight_[kT1] + weight_[kT2]; }
+
+  // 两个淘汰链表中 key 的权重之和
+  size_t ghostWeight() const { return weight_[kB1] + weight_[kB2]; }
+
+  // 设置了过期时间且尚未回收的条目数
+  size_t expiringSize() const { return wheel_.size(); }
+
+  // LRU 部分当前的目标大小 p
+  size_t target() const { return target_; }
+
+  // 每个条目除 key、value 之外的内存开销估算：链表节点的两个指针，条目中的定时器挂钩、权重、计数、位置与频率桶迭代器，
+  // 索引槽位及其控制字节；淘汰链表中的 key 另计，每个只占 sizeof(Ghost) 加链表指针与索引槽位
+  static constexpr size_t nodeOverhead() {
+	  return 2 * sizeof(void *) + sizeof(Entry) - sizeof(Key) - sizeof(Value)
+		  + sizeof(typename NodeMap::value_type) + 1;
+  }
+
+ private:
+  // 写入或更新条目，返回写入后位于主缓存中的条目，放不下时返回 nullptr
+  Entry *insert(Key key, Value value) {
+	  auto weight = weigher_(key, value);
+	  // 查找与插入只探测一次：不存在时先占位，之后再填入条目位置
+	  auto [it, inserted] = index_.emplace(key, Slot());
+	  if (weight > capacity_) {
+		  // 单个条目超过整个容量，放不下，旧值也不再有效
+		  if (!inserted) {
+			  removeSlot(it->second);
 		  }
-		  arcLFU->delEliminateNode(key);
-		  arcLFU->put(key, value);
+		  index_.erase(it);
+		  return nullptr;
+	  }
+
+	  if (inserted) {
+		  makeRoom(weight, false);
+		  t1_.push_front(Entry{TimerHook(), std::move(key), std::move(value), weight, 1, kT1, BucketIt()});
+		  weight_[kT1] += weight;
+		  it->second = t1_.begin();
+		  trimGhosts();
+		  return &t1_.front();
+	  }
+
+	  // 淘汰时只改写索引的值、不删除，it 在腾出空间后仍然有效
+	  if (auto slot = std::get_if<EntryIt>(&it->second)) {
+		  // 已在缓存中，按一次命中处理并原地更新，新值变大时可能需要腾出空间
+		  auto entry = *slot;
+		  weight_[entry->where_] = weight_[entry->where_] - entry->weight_ + weight;
+		  entry->weight_ = weight;
+		  entry->value_ = std::move(value);
+		  touch(entry);
+		  makeRoom(0, false);
+		  // 腾出空间可能淘汰到条目自己，此时它已在淘汰链表中
+		  slot = std::get_if<EntryIt>(&it->second);
+		  return slot ? &**slot : nullptr;
+	  }
+
+	  auto ghost = std::get<GhostIt>(it->second);
+	  bool inB2 = ghost->where_ == kB2;
+	  if (inB2) {
+		  // 命中 LFU 淘汰链表，T1 的目标大小减小
+		  auto ratio = std::max<size_t>(weight_[kB1] / std::max<size_t>(weight_[kB2], 1), 1);
+		  target_ = target_ > ratio * weight ? target_ - ratio * weight : 0;
 	  } else {
-		  arcLRU->put(key, value);
+		  // 命中 LRU 淘汰链表，T1 的目标大小增加
+		  auto ratio = std::max<size_t>(weight_[kB2] / std::max<size_t>(weight_[kB1], 1), 1);
+		  target_ = std::min(capacity_, target_ + ratio * weight);
 	  }
+	  removeGhost(ghost);
+	  makeRoom(weight, inB2);
+	  // 淘汰链表中的 key 再次写入，直接进入 T2
+	  EntryList admitted;
+	  admitted.push_front(Entry{TimerHook(), std::move(key), std::move(value), weight, 1, kT2, BucketIt()});
+	  auto entry = admitted.begin();
+	  weight_[kT2] += weight;
+	  linkToT2(entry, admitted);
+	  it->second = entry;
+	  trimGhosts();
+	  return &*entry;
   }
 
-  std::optional<Value> get(Key key) {
+  // 协作式推进时间轮，过期的条目直接删除，不进入淘汰链表；sampled 为 true 时按采样节奏推进，用于读路径
+  void tick(bool sampled = false) {
+	  if (wheel_.empty() || (sampled && !wheel_.sample())) {
+		  return;
+	  }
+	  wheel_.advance([this](Entry *entry) {
+		auto it = index_.find(entry->key_);
+		if (it != index_.end()) {
+			removeSlot(it->second);
+			index_.erase(it);
+		}
+	  });
+  }
 
-	  if (arcLRU->checkEliminate(key)) {    // 如果在 LRU 淘汰链表
-		  if (arcLFU->decreaseCapacity()) {
-			  arcLRU->increaseCapacity();
-		  }
-		  arcLRU->delEliminateNode(key);
-	  } else if (arcLFU->checkEliminate(key)) {    // 如果在 LFU 淘汰链表
-		  if (arcLRU->decreaseCapacity()) {
-			  arcLFU->increaseCapacity();
-		  }
-		  arcLFU->delEliminateNode(key);
+  // 命中 T1 的条目访问次数加一，达到门槛转移到 T2；命中 T2 的条目频率加一
+  void touch(EntryIt entry) {
+	  if (entry->where_ == kT2) {
+		  promote(entry);
+		  return;
 	  }
+	  if (++entry->count_ >= transformThreshold_) {
+		  weight_[kT1] -= entry->weight_;
+		  weight_[kT2] += entry->weight_;
+		  linkToT2(entry, t1_);
+	  } else {
+		  t1_.splice(t1_.begin(), t1_, entry);
+	  }
+  }
 
-	  auto shouldTransform = false;
-	  auto re = arcLRU->get(key, shouldTransform);
-	  if (re != std::nullopt) {
-		  if (shouldTransform) {
-			  arcLFU->put(key, re.value());
+  // 从 from 移到 T2 频率为 1 的桶尾部，频率为 1 的桶必然是第一个
+  void linkToT2(EntryIt entry, EntryList &from) {
+	  if (buckets_.empty() || buckets_.front().freq_ != 1) {
+		  buckets_.push_front(Bucket{1, EntryList()});
+	  }
+	  auto bucket = buckets_.begin();
+	  bucket->entries_.splice(bucket->entries_.end(), from, entry);
+	  entry->where_ = kT2;
+	  entry->count_ = 1;
+	  entry->bucket_ = bucket;
+  }
+
+  // T2 中的条目频率加一：移动到相邻的下一个频率桶，原桶为空则释放
+  void promote(EntryIt entry) {
+	  auto cur = entry->bucket_;
+	  auto next = std::next(cur);
+	  if (next == buckets_.end() || next->freq_ != cur->freq_ + 1) {
+		  next = buckets_.insert(next, Bucket{cur->freq_ + 1, EntryList()});
+	  }
+	  next->entries_.splice(next->entries_.end(), cur->entries_, entry);
+	  entry->bucket_ = next;
+	  ++entry->count_;
+	  if (cur->entries_.empty()) {
+		  buckets_.erase(cur);
+	  }
+  }
+
+  // 两部分合计放不下 weight 时按 ARC 的替换规则连续淘汰，inB2 表示本次写入命中了 LFU 淘汰链表
+  void makeRoom(size_t weight, bool inB2) {
+	  while (totalWeight() + weight > capacity_) {
+		  auto t1 = weight_[kT1];
+		  if (t1 > 0 && (t1 > target_ || (inB2 && t1 == target_))) {
+			  evictT1();
+		  } else if (!buckets_.empty()) {
+			  evictT2();
+		  } else if (t1 > 0) {
+			  evictT1();
+		  } else {
+			  break;
 		  }
+	  }
+  }
+
+  // T1 最久未访问的条目进入 B1，只保留 key
+  void evictT1() {
+	  auto entry = std::prev(t1_.end());
+	  toGhost(entry, b1_, kB1);
+	  t1_.erase(entry);
+  }
+
+  // T2 最小频率桶中最久未访问的条目进入 B2，只保留 key
+  void evictT2() {
+	  auto bucket = buckets_.begin();
+	  auto entry = bucket->entries_.begin();
+	  toGhost(entry, b2_, kB2);
+	  bucket->entries_.erase(entry);
+	  if (bucket->entries_.empty()) {
+		  buckets_.erase(bucket);
+	  }
+  }
+
+  // 在淘汰链表头部放入条目的 key 与权重，并把索引改为指向它，条目由调用方从所在链表删除
+  void toGhost(EntryIt entry, GhostList &ghost, Where where) {
+	  wheel_.cancel(&*entry);
+	  weight_[entry->where_] -= entry->weight_;
+	  weight_[where] += entry->weight_;
+	  auto it = index_.find(entry->key_);
+	  ghost.push_front(Ghost{std::move(entry->key_), entry->weight_, where});
+	  it->second = ghost.begin();
+  }
+
+  // T1 与 B1 合计不超过 capacity，四者合计不超过 2 * capacity
+  void trimGhosts() {
+	  while (weight_[kT1] + weight_[kB1] > capacity_ && !b1_.empty()) {
+		  dropGhost(b1_);
+	  }
+	  while (totalWeight() + ghostWeight() > 2 * capacity_ && !b2_.empty()) {
+		  dropGhost(b2_);
+	  }
+  }
+
+  // 丢弃淘汰链表中最早的 key
+  void dropGhost(GhostList &ghost) {
+	  auto &node = ghost.back();
+	  weight_[node.where_] -= node.weight_;
+	  index_.erase(node.key_);
+	  ghost.pop_back();
+  }
+
+  // 从所在链表中删除，索引由调用方删除
+  void removeSlot(const Slot &slot) {
+	  if (auto entry = std::get_if<EntryIt>(&slot)) {
+		  removeEntry(*entry);
 	  } else {
-		  re = arcLFU->get(key);
+		  removeGhost(std::get<GhostIt>(slot));
+	  }
+  }
+
+  void removeEntry(EntryIt entry) {
+	  wheel_.cancel(&*entry);
+	  weight_[entry->where_] -= entry->weight_;
+	  if (entry->where_ == kT1) {
+		  t1_.erase(entry);
+		  return;
+	  }
+	  auto bucket = entry->bucket_;
+	  bucket->entries_.erase(entry);
+	  if (bucket->entries_.empty()) {
+		  buckets_.erase(bucket);
 	  }
-	  return re;
+  }
+
+  void removeGhost(GhostIt ghost) {
+	  weight_[ghost->where_] -= ghost->weight_;
+	  (ghost->where_ == kB1 ? b1_ : b2_).erase(ghost);
   }
 
  private:
   size_t capacity_;
   size_t transformThreshold_;
-  std::unique_ptr<ArcLRU<Key, Value>> arcLRU;
-  std::unique_ptr<ArcLFU<Key, Value>> arcLFU;
+  size_t target_;                // LRU 部分（T1）的目标大小 p
+  Weigher weigher_;
+  size_t weight_[4] = {0, 0, 0, 0};    // 四个链表各自的权重之和，按 Where 下标
+  NodeMap index_;                // key 到条目，四个链表共用
+  TimingWheel<Entry> wheel_;        // 设置了过期时间的条目，只包括 T1、T2 中的条目
+  EntryList t1_;                // LRU 部分，头部最近访问
+  BucketList buckets_;            // LFU 部分的频率桶
+  GhostList b1_;                // LRU 部分的淘汰链表，头部最近淘汰
+  GhostList b2_;                // LFU 部分的淘汰链表，头部最近淘汰
 };
 }
 
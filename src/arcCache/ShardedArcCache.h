@@ -0,0 +1,32 @@
+/**
+  ******************************************************************************
+  * @file           : ShardedArcCache.h
+  * @author         : xy
+  * @brief          : 分片加锁的并发 ArcCache
+  * @attention      : get/put 直接在调用线程执行，接口与 ArcCache 相同
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_ARCCACHE_SHARDEDARCCACHE_H_
+#define CACHE_SRC_ARCCACHE_SHARDEDARCCACHE_H_
+
+#include "ArcCache.h"
+#include "ShardedCache.h"
+
+namespace Cache {
+
+/**
+ * @brief 按 key 的哈希拆成若干个独立的 ArcCache 分片，每个分片一把锁，
+ * 各自维护 LRU、LFU 两部分之间的目标大小 p 和淘汰链表，互不影响。
+ * 构造参数为 (总容量, 分片数, transformThreshold[, weigher])，总容量按分片数均分，余数分给前面的分片
+ * @tparam Key
+ * @tparam Value
+ * @tparam Weigher 形如 size_t(const Key &, const Value &)
+ */
+template<typename Key, typename Value, typename Weigher = UnitWeigher<Key, Value>>
+using ShardedArcCache = ShardedCache<Key, Value, ArcCache<Key, Value, Weigher>>;
+
+}
+
+#endif //CACHE_SRC_ARCCACHE_SHARDEDARCCACHE_H_
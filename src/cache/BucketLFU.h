@@ -0,0 +1,126 @@
+/**
+  ******************************************************************************
+  * @file           : BucketLFU.h
+  * @author         : xy
+  * @brief          : O(1) LFU
+  * @attention      : 频率桶用双向链表串联，每个桶持有同频率的节点
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_BUCKETLFU_H_
+#define CACHE_SRC_CACHE_BUCKETLFU_H_
+
+#include <list>
+
+#include "CachePolicy.h"
+#include "FlatMap.h"
+
+namespace Cache {
+
+/**
+ * @brief 经典 O(1) LFU：频率桶按频率升序串成链表，桶内节点按访问先后排列
+ * 节点晋升只需要移动到相邻的下一个桶（不存在则插入一个），空桶立即释放，
+ * 因此最小频率永远是链表第一个桶，不需要 minFreq_，也不存在扫描
+ * @tparam Key
+ * @tparam Value
+ */
+template<typename Key, typename Value>
+class BucketLFU : public CachePolicy<Key, Value> {
+  struct Bucket;
+  using BucketList = std::list<Bucket>;
+  using BucketIt = typename BucketList::iterator;
+
+  struct Entry {
+	  Key key_;
+	  Value value_;
+	  BucketIt bucket_;    // 所在频率桶
+  };
+  using EntryList = std::list<Entry>;
+  using EntryIt = typename EntryList::iterator;
+
+  struct Bucket {
+	  size_t freq_;         // 频率
+	  EntryList entries_;    // 同频率节点，头部最久未访问
+  };
+
+  using NodeMap = FlatMap<Key, EntryIt>;
+ public:
+  explicit BucketLFU(size_t capacity = 1) : capacity_(capacity) {}
+
+  ~BucketLFU() = default;
+
+  void put(Key key, Value value) override {
+	  if (capacity_ <= 0) {
+		  return;
+	  }
+
+	  auto it = nodeMap_.find(key);
+	  if (it != nodeMap_.end()) {
+		  it->second->value_ = std::move(value);
+		  promote(it->second);
+		  return;
+	  }
+
+	  // 缓存已满，淘汰最小频率桶中最久未访问的节点
+	  if (nodeMap_.size() >= capacity_) {
+		  removeMinFreqNode();
+	  }
+
+	  // 新节点频率为 1，必然位于第一个桶
+	  if (buckets_.empty() || buckets_.front().freq_ != 1) {
+		  buckets_.push_front(Bucket{1, EntryList()});
+	  }
+	  auto bucket = buckets_.begin();
+	  bucket->entries_.push_back(Entry{key, std::move(value), bucket});
+	  nodeMap_.emplace(std::move(key), std::prev(bucket->entries_.end()));
+  }
+
+  std::optional<Value> get(const Key &key) override {
+	  auto it = nodeMap_.find(key);
+	  if (it == nodeMap_.end()) {
+		  return std::nullopt;
+	  }
+	  promote(it->second);
+	  return it->second->value_;
+  }
+
+  size_t size() const { return nodeMap_.size(); }
+
+  // 当前频率桶数量，不会超过节点数
+  size_t bucketNum() const { return buckets_.size(); }
+
+ private:
+  // 节点频率加一：移动到相邻的下一个频率桶，原桶为空则释放
+  void promote(EntryIt entry) {
+	  auto cur = entry->bucket_;
+	  auto next = std::next(cur);
+	  if (next == buckets_.end() || next->freq_ != cur->freq_ + 1) {
+		  next = buckets_.insert(next, Bucket{cur->freq_ + 1, EntryList()});
+	  }
+	  next->entries_.splice(next->entries_.end(), cur->entries_, entry);
+	  entry->bucket_ = next;
+	  if (cur->entries_.empty()) {
+		  buckets_.erase(cur);
+	  }
+  }
+
+  void removeMinFreqNode() {
+	  if (buckets_.empty()) return;
+	  auto bucket = buckets_.begin();
+	  nodeMap_.erase(bucket->entries_.front().key_);
+	  bucket->entries_.pop_front();
+	  if (bucket->entries_.empty()) {
+		  buckets_.erase(bucket);
+	  }
+  }
+
+ private:
+  size_t capacity_;        // 缓存容量
+  NodeMap nodeMap_;        // key 到节点的索引
+  BucketList buckets_;    // 频率桶，按频率升序排列
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_BUCKETLFU_H_
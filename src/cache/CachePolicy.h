@@ -18,7 +18,7 @@ template<typename Key, typename Value>
 class CachePolicy {
  public:
   virtual ~CachePolicy() = default;
-  virtual std::optional<Value> get(Key key) = 0;
+  virtual std::optional<Value> get(const Key &key) = 0;
   virtual void put(Key key, Value value) = 0;
 };
 }
@@ -0,0 +1,39 @@
+/**
+  ******************************************************************************
+  * @file           : CacheRoute.h
+  * @author         : xy
+  * @brief          : 多线程缓存的请求路由方式
+  * @attention      : LRUCache 与 LFUCache 共用
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_CACHEROUTE_H_
+#define CACHE_SRC_CACHE_CACHEROUTE_H_
+
+#include <cstdint>
+
+#include "FlatMap.h"
+
+namespace Cache {
+
+/**
+ * @brief RoundRobin：由调用方指定线程，index 越界时轮询，每个线程各存一份，依靠定时同步互相可见；
+ * HashAffinity：由 key 的哈希决定唯一的归属线程，忽略 index，每个 key 只存一份，不需要同步，
+ * 总容量为 capacity * threadNum
+ */
+enum class RouteMode {
+  RoundRobin,
+  HashAffinity
+};
+
+// key 归属的线程下标，乘法常数与 FlatMap 内部不同，避免同一线程内的 key 在哈希表中聚集
+template<typename Key>
+size_t routeOf(const Key &key, size_t threadNum) {
+	uint64_t hash = static_cast<uint64_t>(CacheHash<Key>{}(key)) * 0xC2B2AE3D27D4EB4FULL;
+	return static_cast<size_t>(((hash >> 32) * threadNum) >> 32);
+}
+
+}
+
+#endif //CACHE_SRC_CACHE_CACHEROUTE_H_
@@ -0,0 +1,34 @@
+/**
+  ******************************************************************************
+  * @file           : CacheWeigher.h
+  * @author         : xy
+  * @brief          : 缓存条目的权重计算
+  * @attention      : 缓存容量是权重之和的上限，默认每个条目权重为 1，即按条目数计算
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_CACHEWEIGHER_H_
+#define CACHE_SRC_CACHE_CACHEWEIGHER_H_
+
+#include <cstddef>
+
+namespace Cache {
+
+/**
+ * @brief 权重计算器的形式为 size_t(const Key &, const Value &)，
+ * 按字节计算时返回条目占用的字节数，容量即为字节预算
+ * @tparam Key
+ * @tparam Value
+ */
+template<typename Key, typename Value>
+struct UnitWeigher {
+  size_t operator()(const Key &, const Value &) const { return 1; }
+};
+
+// std::make_shared 与对象一起分配的控制块（虚表指针与两个引用计数），用于估算每个节点的额外开销
+constexpr size_t kSharedBlockOverhead = sizeof(void *) + 2 * sizeof(int);
+
+}
+
+#endif //CACHE_SRC_CACHE_CACHEWEIGHER_H_
@@ -0,0 +1,112 @@
+/**
+  ******************************************************************************
+  * @file           : ChangeSet.h
+  * @author         : xy
+  * @brief          : 分片写入的脏 key 集合，用于多线程缓存之间的增量同步
+  * @attention      : 不加锁，只能由分片所在的工作线程访问
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_CHANGESET_H_
+#define CACHE_SRC_CACHE_CHANGESET_H_
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "FlatMap.h"
+
+namespace Cache {
+
+template<typename Key, typename Value>
+struct ChangeEntry {
+  uint64_t version_;    // 写入时取自所有分片共享的计数，越大越新
+  Key key_;
+  Value value_;
+  std::optional<std::chrono::nanoseconds> ttl_;    // 剩余的过期时间，没有设置过期时间时为空
+};
+
+/**
+ * @brief 只记录自上次同步以来写过的 key 及最后一次写入的版本号，不保存 value：
+ * 同一个 key 多次写入只占一项，同步时再从缓存中读出当前值。
+ * 脏 key 另按首次写入顺序存在数组中，取走时只遍历数组并逐个从索引中删除，不遍历也不清空整个索引：
+ * 索引的槽位数不会缩小，一次大批量写入之后仍很大，同步开销仍只与这段时间内写过的 key 数有关
+ * @tparam Key
+ * @tparam Value
+ */
+template<typename Key, typename Value>
+class ChangeSet {
+ public:
+  using Entry = ChangeEntry<Key, Value>;
+
+  explicit ChangeSet(size_t capacity) : capacity_(capacity) {}
+
+  ~ChangeSet() = default;
+
+  // lookup 形如 std::optional<Value>(const Key &)，用于清理已被淘汰的 key
+  template<typename Lookup>
+  void mark(const Key &key, uint64_t version, Lookup &&lookup) {
+	  auto [it, inserted] = versions_.emplace(key, version);
+	  if (inserted) {
+		  keys_.push_back(key);
+	  } else {
+		  it->second = version;
+	  }
+	  // 写过的 key 远多于缓存容量时，大部分已被淘汰，不必等到同步再丢弃
+	  if (keys_.size() > 2 * capacity_) {
+		  prune(lookup);
+	  }
+  }
+
+  /**
+   * @brief 取走全部脏 key，并用 lookup 读出当前值，已被淘汰的 key 不再同步
+   * @param lookup 形如 std::optional<Value>(const Key &)，不应改变淘汰顺序
+   */
+  template<typename Lookup>
+  std::vector<Entry> drain(Lookup &&lookup) {
+	  std::vector<Entry> entries;
+	  entries.reserve(keys_.size());
+	  for (auto &key : keys_) {
+		  auto it = versions_.find(key);
+		  auto version = it->second;
+		  versions_.erase(it);
+		  if (auto value = lookup(key)) {
+			  entries.push_back(Entry{version, std::move(key), std::move(*value), std::nullopt});
+		  }
+	  }
+	  keys_.clear();
+	  return entries;
+  }
+
+  size_t size() const { return keys_.size(); }
+
+ private:
+  // 丢弃已被淘汰的 key，只遍历脏 key 本身
+  template<typename Lookup>
+  void prune(Lookup &lookup) {
+	  size_t live = 0;
+	  for (size_t i = 0; i < keys_.size(); ++i) {
+		  if (!lookup(keys_[i])) {
+			  versions_.erase(keys_[i]);
+		  } else if (live++ != i) {
+			  keys_[live - 1] = std::move(keys_[i]);
+		  }
+	  }
+	  keys_.erase(keys_.begin() + live, keys_.end());
+  }
+
+ public:
+// 删除拷贝语义
+  ChangeSet(const ChangeSet &other) = delete;
+  ChangeSet &operator=(const ChangeSet &other) = delete;
+ private:
+  size_t capacity_;
+  std::vector<Key> keys_;             // 脏 key，按首次写入的顺序，每个 key 一项
+  FlatMap<Key, uint64_t> versions_;    // 脏 key 到最后一次写入的版本号
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_CHANGESET_H_
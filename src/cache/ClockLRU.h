@@ -0,0 +1,112 @@
+/**
+  ******************************************************************************
+  * @file           : ClockLRU.h
+  * @author         : xy
+  * @brief          : CLOCK（二次机会）近似 LRU
+  * @attention      : 命中只设置访问位，不修改链表，读操作之间可以并发
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_CLOCKLRU_H_
+#define CACHE_SRC_CACHE_CLOCKLRU_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#include "CachePolicy.h"
+#include "FlatMap.h"
+
+namespace Cache {
+
+/**
+ * @brief 缓存条目放在一个环形数组中，每个条目一个访问位
+ * get 命中时只原子地置位访问位，因此只需要共享锁；
+ * put 需要淘汰时，指针沿环形数组扫描：访问位为 1 的清零并跳过（给第二次机会），遇到为 0 的即淘汰
+ * @tparam Key
+ * @tparam Value
+ */
+template<typename Key, typename Value>
+class ClockLRU : public CachePolicy<Key, Value> {
+  using NodeMap = FlatMap<Key, size_t>;
+ public:
+  explicit ClockLRU(size_t capacity)
+	  : capacity_(capacity), size_(0), hand_(0), slots_(std::make_unique<Slot[]>(capacity)) {}
+
+  ~ClockLRU() = default;
+
+  void put(Key key, Value value) override {
+	  if (capacity_ <= 0) {
+		  return;
+	  }
+
+	  std::unique_lock<std::shared_mutex> lock(mutex_);
+	  // 如果存在，更新节点值，并置位访问位
+	  auto it = nodeMap_.find(key);
+	  if (it != nodeMap_.end()) {
+		  auto &slot = slots_[it->second];
+		  slot.value_ = std::move(value);
+		  slot.ref_.store(true, std::memory_order_relaxed);
+		  return;
+	  }
+
+	  size_t index = size_ < capacity_ ? size_++ : evict();
+	  auto &slot = slots_[index];
+	  slot.key_ = key;
+	  slot.value_ = std::move(value);
+	  slot.ref_.store(false, std::memory_order_relaxed);
+	  nodeMap_.emplace(std::move(key), index);
+  }
+
+  std::optional<Value> get(const Key &key) override {
+	  std::shared_lock<std::shared_mutex> lock(mutex_);
+	  auto it = nodeMap_.find(key);
+	  if (it == nodeMap_.end()) {
+		  return std::nullopt;
+	  }
+	  auto &slot = slots_[it->second];
+	  // 已经置位就不再写，避免热点条目所在缓存行在读线程之间来回失效
+	  if (!slot.ref_.load(std::memory_order_relaxed)) {
+		  slot.ref_.store(true, std::memory_order_relaxed);
+	  }
+	  return slot.value_;
+  }
+
+  size_t size() const {
+	  std::shared_lock<std::shared_mutex> lock(mutex_);
+	  return size_;
+  }
+
+ private:
+  struct Slot {
+	  Key key_;
+	  Value value_;
+	  std::atomic<bool> ref_{false};    // 访问位
+  };
+
+  // 转动指针找到淘汰位置，调用方持有写锁
+  size_t evict() {
+	  while (slots_[hand_].ref_.load(std::memory_order_relaxed)) {
+		  slots_[hand_].ref_.store(false, std::memory_order_relaxed);
+		  hand_ = (hand_ + 1) % capacity_;
+	  }
+	  auto victim = hand_;
+	  hand_ = (hand_ + 1) % capacity_;
+	  nodeMap_.erase(slots_[victim].key_);
+	  return victim;
+  }
+
+ private:
+  size_t capacity_;                    // 缓存容量
+  size_t size_;                        // 已使用的条目数
+  size_t hand_;                        // 时钟指针
+  std::unique_ptr<Slot[]> slots_;    // 环形数组
+  NodeMap nodeMap_;                    // key 到数组下标
+  mutable std::shared_mutex mutex_;    // 读共享，写独占
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_CLOCKLRU_H_
@@ -0,0 +1,442 @@
+/**
+  ******************************************************************************
+  * @file           : FlatMap.h
+  * @author         : xy
+  * @brief          : 开放寻址哈希表，缓存策略的 key 索引
+  * @attention      : Swiss table 结构，控制字节按 16 个一组用 SSE2 并行比较；迭代器在插入后失效
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_FLATMAP_H_
+#define CACHE_SRC_CACHE_FLATMAP_H_
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace Cache {
+
+/**
+ * @brief FlatMap 默认使用的哈希，std::string 特化为透明哈希：
+ * 可以直接用 std::string_view 或 const char * 查找，不需要先构造一个 std::string
+ */
+template<typename Key>
+struct CacheHash : std::hash<Key> {};
+
+template<>
+struct CacheHash<std::string> {
+  using is_transparent = void;
+
+  size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+};
+
+/**
+ * @brief 一组 16 个控制字节，返回满足条件的槽位掩码（第 i 位为 1 表示第 i 个槽位满足）
+ * 控制字节：最高位为 1 表示空槽或墓碑，否则低 7 位存储该槽位 key 的哈希片段 h2
+ */
+class FlatGroup {
+ public:
+  static constexpr size_t kWidth = 16;
+  static constexpr int8_t kEmpty = -128;    // 0b10000000
+  static constexpr int8_t kDeleted = -2;    // 0b11111110
+
+  explicit FlatGroup(const int8_t *ctrl) {
+#ifdef __SSE2__
+	  ctrl_ = _mm_load_si128(reinterpret_cast<const __m128i *>(ctrl));
+#else
+	  std::memcpy(ctrl_, ctrl, kWidth);
+#endif
+  }
+
+  // 控制字节等于 h2 的槽位
+  uint32_t match(int8_t h2) const {
+#ifdef __SSE2__
+	  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+#else
+	  uint32_t mask = 0;
+	  for (size_t i = 0; i < kWidth; ++i) {
+		  if (ctrl_[i] == h2) mask |= 1u << i;
+	  }
+	  return mask;
+#endif
+  }
+
+  uint32_t matchEmpty() const { return match(kEmpty); }
+
+  // 空槽或墓碑，即最高位为 1 的槽位
+  uint32_t matchEmptyOrDeleted() const {
+#ifdef __SSE2__
+	  return static_cast<uint32_t>(_mm_movemask_epi8(ctrl_));
+#else
+	  uint32_t mask = 0;
+	  for (size_t i = 0; i < kWidth; ++i) {
+		  if (ctrl_[i] < 0) mask |= 1u << i;
+	  }
+	  return mask;
+#endif
+  }
+
+ private:
+#ifdef __SSE2__
+  __m128i ctrl_;
+#else
+  int8_t ctrl_[kWidth];
+#endif
+};
+
+/**
+ * @brief 开放寻址哈希表：控制字节和槽位各自连续存放，一次查找先比较一组控制字节，
+ * 通常只需要再访问一个槽位。槽位数为 16 的整数倍（2 的幂），按组做二次探测，
+ * 负载因子上限 7/8，删除产生的墓碑在空间不足时原地重排回收，不重新分配内存
+ * @tparam Key
+ * @tparam T
+ * @tparam Hash
+ * @tparam KeyEqual
+ */
+template<typename Key, typename T, typename Hash = CacheHash<Key>, typename KeyEqual = std::equal_to<>>
+class FlatMap {
+  using Group = FlatGroup;
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+
+  // K 与 Key 不同且哈希声明了 is_transparent 时才启用异构查找
+  template<typename K, typename = void>
+  struct IsTransparent : std::false_type {};
+  template<typename K>
+  struct IsTransparent<K, std::void_t<typename Hash::is_transparent>>
+	  : std::bool_constant<!std::is_same_v<std::decay_t<K>, Key>> {};
+
+  template<bool Const>
+  class Iterator {
+	  friend class FlatMap;
+	  friend class Iterator<!Const>;
+	  using MapPtr = std::conditional_t<Const, const FlatMap *, FlatMap *>;
+   public:
+	  using reference = std::conditional_t<Const, const value_type &, value_type &>;
+	  using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+
+	  Iterator() = default;
+	  Iterator(MapPtr map, size_t index) : map_(map), index_(index) { skipEmpty(); }
+	  // 普通迭代器可以转换为 const 迭代器
+	  template<bool C = Const, typename = std::enable_if_t<C>>
+	  Iterator(const Iterator<false> &other) : map_(other.map_), index_(other.index_) {}
+
+	  reference operator*() const { return map_->slots_[index_]; }
+	  pointer operator->() const { return &map_->slots_[index_]; }
+
+	  Iterator &operator++() {
+		  ++index_;
+		  skipEmpty();
+		  return *this;
+	  }
+
+	  bool operator==(const Iterator &other) const { return index_ == other.index_; }
+	  bool operator!=(const Iterator &other) const { return index_ != other.index_; }
+
+   private:
+	  void skipEmpty() {
+		  while (index_ < map_->capacity_ && map_->ctrl_[index_] < 0) {
+			  ++index_;
+		  }
+	  }
+
+	  MapPtr map_ = nullptr;
+	  size_t index_ = 0;
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  FlatMap() = default;
+
+  explicit FlatMap(size_t n) { reserve(n); }
+
+  ~FlatMap() { destroy(); }
+
+  FlatMap(FlatMap &&other) noexcept { moveFrom(other); }
+
+  FlatMap &operator=(FlatMap &&other) noexcept {
+	  if (this != &other) {
+		  destroy();
+		  moveFrom(other);
+	  }
+	  return *this;
+  }
+
+  FlatMap(const FlatMap &other) = delete;
+  FlatMap &operator=(const FlatMap &other) = delete;
+
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, capacity_); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, capacity_); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_t capacity() const { return capacity_; }
+
+  iterator find(const Key &key) { return iterator(this, findIndex(key)); }
+  const_iterator find(const Key &key) const { return const_iterator(this, findIndex(key)); }
+
+  // 异构查找，仅在哈希为透明哈希时可用
+  template<typename K, typename = std::enable_if_t<IsTransparent<K>::value>>
+  iterator find(const K &key) { return iterator(this, findIndex(key)); }
+  template<typename K, typename = std::enable_if_t<IsTransparent<K>::value>>
+  const_iterator find(const K &key) const { return const_iterator(this, findIndex(key)); }
+
+  size_t count(const Key &key) const { return findIndex(key) == capacity_ ? 0 : 1; }
+
+  template<typename K, typename... Args>
+  std::pair<iterator, bool> emplace(K &&key, Args &&... args) {
+	  auto hash = hashOf(key);
+	  auto index = findIndex(key, hash);
+	  if (index != capacity_) {
+		  return {iterator(this, index), false};
+	  }
+	  index = prepareInsert(hash);
+	  new(&slots_[index]) value_type(std::piecewise_construct,
+									 std::forward_as_tuple(std::forward<K>(key)),
+									 std::forward_as_tuple(std::forward<Args>(args)...));
+	  return {iterator(this, index), true};
+  }
+
+  template<typename K, typename V>
+  std::pair<iterator, bool> insert_or_assign(K &&key, V &&value) {
+	  auto result = emplace(std::forward<K>(key), std::forward<V>(value));
+	  if (!result.second) {
+		  result.first->second = std::forward<V>(value);
+	  }
+	  return result;
+  }
+
+  T &operator[](const Key &key) { return emplace(key).first->second; }
+  T &operator[](Key &&key) { return emplace(std::move(key)).first->second; }
+
+  void erase(iterator it) { eraseAt(it.index_); }
+
+  size_t erase(const Key &key) {
+	  auto index = findIndex(key);
+	  if (index == capacity_) {
+		  return 0;
+	  }
+	  eraseAt(index);
+	  return 1;
+  }
+
+  void clear() {
+	  for (size_t i = 0; i < capacity_; ++i) {
+		  if (ctrl_[i] >= 0) {
+			  slots_[i].~value_type();
+		  }
+	  }
+	  if (capacity_ > 0) {
+		  std::memset(ctrl_, Group::kEmpty, capacity_);
+	  }
+	  size_ = 0;
+	  growthLeft_ = maxLoad(capacity_);
+  }
+
+  // 预留空间，保证插入 n 个元素前不会扩容
+  void reserve(size_t n) {
+	  size_t cap = Group::kWidth;
+	  while (maxLoad(cap) < n) {
+		  cap <<= 1;
+	  }
+	  if (cap > capacity_) {
+		  resize(cap);
+	  }
+  }
+
+ private:
+  static size_t maxLoad(size_t cap) { return cap - cap / 8; }
+
+  // 先打散再使用：低 7 位作为控制字节里的 h2，其余位决定起始探测组
+  template<typename K>
+  size_t hashOf(const K &key) const {
+	  uint64_t hash = static_cast<uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ULL;
+	  return static_cast<size_t>(hash ^ (hash >> 32));
+  }
+
+  static int8_t h2(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+
+  size_t groupMask() const { return capacity_ / Group::kWidth - 1; }
+
+  template<typename K>
+  size_t findIndex(const K &key) const { return findIndex(key, hashOf(key)); }
+
+  // 按组探测，组内用 SIMD 比较 h2，遇到含空槽的组即可停止
+  template<typename K>
+  size_t findIndex(const K &key, size_t hash) const {
+	  if (capacity_ == 0) {
+		  return capacity_;
+	  }
+	  auto mask = groupMask();
+	  auto group = (hash >> 7) & mask;
+	  for (size_t step = 1;; ++step) {
+		  Group g(ctrl_ + group * Group::kWidth);
+		  for (auto bits = g.match(h2(hash)); bits != 0; bits &= bits - 1) {
+			  auto index = group * Group::kWidth + __builtin_ctz(bits);
+			  if (KeyEqual{}(slots_[index].first, key)) {
+				  return index;
+			  }
+		  }
+		  if (g.matchEmpty() != 0) {
+			  return capacity_;
+		  }
+		  group = (group + step) & mask;
+	  }
+  }
+
+  // 沿探测序列找第一个空槽或墓碑
+  size_t findFirstNonFull(size_t hash) const {
+	  auto mask = groupMask();
+	  auto group = (hash >> 7) & mask;
+	  for (size_t step = 1;; ++step) {
+		  auto bits = Group(ctrl_ + group * Group::kWidth).matchEmptyOrDeleted();
+		  if (bits != 0) {
+			  return group * Group::kWidth + __builtin_ctz(bits);
+		  }
+		  group = (group + step) & mask;
+	  }
+  }
+
+  // 为新元素找到槽位并写入控制字节，必要时先回收墓碑或扩容
+  size_t prepareInsert(size_t hash) {
+	  if (capacity_ == 0) {
+		  resize(Group::kWidth);
+	  }
+	  auto index = findFirstNonFull(hash);
+	  if (growthLeft_ == 0 && ctrl_[index] == Group::kEmpty) {
+		  // 墓碑较多时原地重排，否则容量翻倍
+		  if (size_ * 2 <= maxLoad(capacity_)) {
+			  dropDeletes();
+		  } else {
+			  resize(capacity_ * 2);
+		  }
+		  index = findFirstNonFull(hash);
+	  }
+	  if (ctrl_[index] == Group::kEmpty) {
+		  --growthLeft_;
+	  }
+	  ctrl_[index] = h2(hash);
+	  ++size_;
+	  return index;
+  }
+
+  void eraseAt(size_t index) {
+	  slots_[index].~value_type();
+	  --size_;
+	  // 所在组本来就有空槽，说明没有探测序列会越过这个组，可以直接置空
+	  if (Group(ctrl_ + index / Group::kWidth * Group::kWidth).matchEmpty() != 0) {
+		  ctrl_[index] = Group::kEmpty;
+		  ++growthLeft_;
+	  } else {
+		  ctrl_[index] = Group::kDeleted;
+	  }
+  }
+
+  /**
+   * @brief 原地回收墓碑：先把墓碑置空、把存活元素标记为待放置（kDeleted），
+   * 再把每个待放置元素移到探测序列上的第一个可用位置
+   */
+  void dropDeletes() {
+	  for (size_t i = 0; i < capacity_; ++i) {
+		  ctrl_[i] = ctrl_[i] == Group::kDeleted ? Group::kEmpty : (ctrl_[i] >= 0 ? Group::kDeleted : ctrl_[i]);
+	  }
+	  for (size_t i = 0; i < capacity_; ++i) {
+		  if (ctrl_[i] != Group::kDeleted) {
+			  continue;
+		  }
+		  auto hash = hashOf(slots_[i].first);
+		  auto target = findFirstNonFull(hash);
+		  // 目标位置与当前位置在同一组，不需要移动
+		  if (target / Group::kWidth == i / Group::kWidth) {
+			  ctrl_[i] = h2(hash);
+			  continue;
+		  }
+		  if (ctrl_[target] == Group::kEmpty) {
+			  new(&slots_[target]) value_type(std::move(slots_[i]));
+			  slots_[i].~value_type();
+			  ctrl_[target] = h2(hash);
+			  ctrl_[i] = Group::kEmpty;
+		  } else {
+			  // 目标位置也是待放置元素，交换后重新处理当前位置
+			  std::swap(slots_[i], slots_[target]);
+			  ctrl_[target] = h2(hash);
+			  --i;
+		  }
+	  }
+	  growthLeft_ = maxLoad(capacity_) - size_;
+  }
+
+  void resize(size_t newCapacity) {
+	  auto oldCtrl = ctrl_;
+	  auto oldSlots = slots_;
+	  auto oldCapacity = capacity_;
+
+	  ctrl_ = static_cast<int8_t *>(::operator new(newCapacity, std::align_val_t(Group::kWidth)));
+	  std::memset(ctrl_, Group::kEmpty, newCapacity);
+	  slots_ = std::allocator<value_type>().allocate(newCapacity);
+	  capacity_ = newCapacity;
+	  growthLeft_ = maxLoad(newCapacity) - size_;
+
+	  for (size_t i = 0; i < oldCapacity; ++i) {
+		  if (oldCtrl[i] >= 0) {
+			  auto hash = hashOf(oldSlots[i].first);
+			  auto index = findFirstNonFull(hash);
+			  ctrl_[index] = h2(hash);
+			  new(&slots_[index]) value_type(std::move(oldSlots[i]));
+			  oldSlots[i].~value_type();
+		  }
+	  }
+	  if (oldCtrl != nullptr) {
+		  ::operator delete(oldCtrl, std::align_val_t(Group::kWidth));
+		  std::allocator<value_type>().deallocate(oldSlots, oldCapacity);
+	  }
+  }
+
+  void destroy() {
+	  if (ctrl_ == nullptr) {
+		  return;
+	  }
+	  clear();
+	  ::operator delete(ctrl_, std::align_val_t(Group::kWidth));
+	  std::allocator<value_type>().deallocate(slots_, capacity_);
+	  ctrl_ = nullptr;
+	  slots_ = nullptr;
+	  capacity_ = 0;
+	  growthLeft_ = 0;
+  }
+
+  void moveFrom(FlatMap &other) {
+	  ctrl_ = std::exchange(other.ctrl_, nullptr);
+	  slots_ = std::exchange(other.slots_, nullptr);
+	  capacity_ = std::exchange(other.capacity_, 0);
+	  size_ = std::exchange(other.size_, 0);
+	  growthLeft_ = std::exchange(other.growthLeft_, 0);
+  }
+
+ private:
+  int8_t *ctrl_ = nullptr;        // 控制字节，按 16 字节对齐
+  value_type *slots_ = nullptr;    // 槽位
+  size_t capacity_ = 0;            // 槽位数，16 的整数倍且为 2 的幂
+  size_t size_ = 0;                // 元素个数
+  size_t growthLeft_ = 0;        // 不扩容还能占用的空槽数
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_FLATMAP_H_
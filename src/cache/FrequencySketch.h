@@ -0,0 +1,108 @@
+/**
+  ******************************************************************************
+  * @file           : FrequencySketch.h
+  * @author         : xy
+  * @brief          : 4 位 count-min sketch，估算 key 的近期访问频次
+  * @attention      : 不加锁；每个条目约 8 字节，定期减半计数，频次只反映近期的访问
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_FREQUENCYSKETCH_H_
+#define CACHE_SRC_CACHE_FREQUENCYSKETCH_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "FlatMap.h"
+
+namespace Cache {
+
+/**
+ * @brief 计数器为 4 位，最大 15，一个 uint64_t 存 16 个。每个 key 在 4 个字中各占一个计数器，
+ * 4 个字由 4 个不同的哈希选出，字内的位置由 key 的哈希决定，估算值取 4 个计数器的最小值。
+ * 表的字数为容量向上取整到 2 的幂，累计增加 10 * 容量次后所有计数器减半，旧的热点会逐渐冷却
+ * @tparam Key
+ */
+template<typename Key>
+class FrequencySketch {
+  static constexpr uint64_t kResetMask = 0x7777777777777777ULL;
+  static constexpr uint64_t kSeeds[4] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+										 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL};
+ public:
+  explicit FrequencySketch(size_t capacity) : additions_(0) {
+	  size_t words = 1;
+	  while (words < capacity) {
+		  words <<= 1;
+	  }
+	  table_.assign(words, 0);
+	  mask_ = words - 1;
+	  sampleSize_ = std::max<size_t>(10 * capacity, 16);
+  }
+
+  ~FrequencySketch() = default;
+
+  // 估算频次，0 ~ 15
+  int frequency(const Key &key) const {
+	  auto hash = spread(key);
+	  auto start = (hash & 3) << 2;
+	  int freq = 15;
+	  for (int i = 0; i < 4; ++i) {
+		  auto word = table_[indexOf(hash, i)];
+		  freq = std::min(freq, static_cast<int>((word >> ((start + i) << 2)) & 0xF));
+	  }
+	  return freq;
+  }
+
+  // 记录一次访问，已经饱和的计数器保持 15
+  void increment(const Key &key) {
+	  auto hash = spread(key);
+	  auto start = (hash & 3) << 2;
+	  bool added = false;
+	  for (int i = 0; i < 4; ++i) {
+		  auto &word = table_[indexOf(hash, i)];
+		  auto offset = (start + i) << 2;
+		  if (((word >> offset) & 0xF) != 0xF) {
+			  word += uint64_t(1) << offset;
+			  added = true;
+		  }
+	  }
+	  if (added && ++additions_ == sampleSize_) {
+		  reset();
+	  }
+  }
+
+  // sketch 占用的字节数
+  size_t memoryUsage() const { return table_.size() * sizeof(uint64_t); }
+
+ private:
+  static uint64_t spread(const Key &key) {
+	  uint64_t hash = static_cast<uint64_t>(CacheHash<Key>{}(key)) * 0x9E3779B97F4A7C15ULL;
+	  return hash ^ (hash >> 32);
+  }
+
+  size_t indexOf(uint64_t hash, int i) const {
+	  hash = (hash + kSeeds[i]) * kSeeds[i];
+	  hash += hash >> 32;
+	  return static_cast<size_t>(hash) & mask_;
+  }
+
+  // 所有计数器减半：整体右移一位后清掉从相邻计数器移入的最高位
+  void reset() {
+	  for (auto &word : table_) {
+		  word = (word >> 1) & kResetMask;
+	  }
+	  additions_ /= 2;
+  }
+
+ private:
+  std::vector<uint64_t> table_;    // 计数器表，每个字 16 个 4 位计数器
+  size_t mask_;                    // 字下标掩码
+  size_t sampleSize_;            // 累计增加多少次后减半
+  size_t additions_;            // 上次减半以来的增加次数
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_FREQUENCYSKETCH_H_
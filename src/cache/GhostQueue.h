@@ -0,0 +1,69 @@
+/**
+  ******************************************************************************
+  * @file           : GhostQueue.h
+  * @author         : xy
+  * @brief          : 容量固定的幽灵 FIFO，只记录最近被淘汰的 key
+  * @attention      : 不加锁，由所属的淘汰策略管理；构造后不再分配内存
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_GHOSTQUEUE_H_
+#define CACHE_SRC_CACHE_GHOSTQUEUE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "FlatMap.h"
+
+namespace Cache {
+
+/**
+ * @brief key 按进入先后写入环形数组，满了覆盖最早的；map 记录 key 最近一次进入的序号，
+ * 被覆盖的 key 只有序号一致时才从 map 删除，因此被提前取出或重复进入的 key 不需要链表维护
+ * @tparam Key
+ */
+template<typename Key>
+class GhostQueue {
+ public:
+  explicit GhostQueue(size_t capacity) : keys_(std::max<size_t>(capacity, 1)), seq_(0) {
+	  map_.reserve(keys_.size());
+  }
+
+  ~GhostQueue() = default;
+
+  // 加入队列，超出容量时丢弃最早的 key
+  void push(const Key &key) {
+	  auto slot = seq_ % keys_.size();
+	  if (seq_ >= keys_.size()) {
+		  auto old = map_.find(keys_[slot]);
+		  if (old != map_.end() && old->second == seq_ - keys_.size()) {
+			  map_.erase(old);
+		  }
+	  }
+	  keys_[slot] = key;
+	  map_.insert_or_assign(key, seq_++);
+  }
+
+  // 在队列中则移除并返回 true
+  bool take(const Key &key) {
+	  auto it = map_.find(key);
+	  if (it == map_.end()) {
+		  return false;
+	  }
+	  map_.erase(it);
+	  return true;
+  }
+
+  size_t size() const { return map_.size(); }
+
+ private:
+  std::vector<Key> keys_;            // 环形数组
+  FlatMap<Key, uint64_t> map_;        // key 到最近一次进入的序号
+  uint64_t seq_;                    // 下一个进入的序号
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_GHOSTQUEUE_H_
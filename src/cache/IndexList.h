@@ -0,0 +1,98 @@
+/**
+  ******************************************************************************
+  * @file           : IndexList.h
+  * @author         : xy
+  * @brief          : 下标化的节点池，节点分属若干条带虚拟节点的双向循环链表
+  * @attention      : 不加锁；节点一次性分配在连续数组中，链接与摘除都不分配内存
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_INDEXLIST_H_
+#define CACHE_SRC_CACHE_INDEXLIST_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Cache {
+
+/**
+ * @brief 多条链表共用一个节点池：下标 [0, capacity) 为普通节点，之后 kLists 个为各链表的虚拟节点，
+ * 每条链表头部最新、尾部最旧，并记录自己的条目数。节点只能同时在一条链表中，
+ * 摘除时按节点记录的 list_ 扣减条目数。节点不要求可移动，可以包含原子成员
+ * @tparam Node 节点类型，需要有 Index 类型的 prev_、next_ 成员和 List 类型的 list_ 成员
+ * @tparam List 链表编号的枚举类型，取值为 0 ~ kLists - 1
+ * @tparam kLists 链表条数
+ */
+template<typename Node, typename List, int kLists>
+class IndexList {
+ public:
+  using Index = uint32_t;
+  static constexpr Index kNil = UINT32_MAX;
+
+  explicit IndexList(size_t capacity)
+	  : capacity_(capacity), nodes_(std::make_unique<Node[]>(capacity + kLists)) {
+	  assert(capacity_ + kLists < kNil);
+	  for (int list = 0; list < kLists; ++list) {
+		  auto head = sentinel(static_cast<List>(list));
+		  nodes_[head].prev_ = head;
+		  nodes_[head].next_ = head;
+		  count_[list] = 0;
+	  }
+  }
+
+  ~IndexList() = default;
+
+  Node &operator[](Index index) { return nodes_[index]; }
+
+  const Node &operator[](Index index) const { return nodes_[index]; }
+
+  size_t count(List list) const { return count_[list]; }
+
+  // 链表中最旧的节点，链表为空时返回虚拟节点，调用方先用 count 判断
+  Index tail(List list) const { return nodes_[sentinel(list)].prev_; }
+
+  // 插入到链表头部
+  void link(Index index, List list) {
+	  auto head = sentinel(list);
+	  auto &node = nodes_[index];
+	  node.list_ = list;
+	  node.next_ = nodes_[head].next_;
+	  node.prev_ = head;
+	  nodes_[nodes_[head].next_].prev_ = index;
+	  nodes_[head].next_ = index;
+	  ++count_[list];
+  }
+
+  void unlink(Index index) {
+	  auto &node = nodes_[index];
+	  nodes_[node.prev_].next_ = node.next_;
+	  nodes_[node.next_].prev_ = node.prev_;
+	  --count_[node.list_];
+  }
+
+  // 移到 list 的头部，可以是原来所在的链表
+  void move(Index index, List list) {
+	  unlink(index);
+	  link(index, list);
+  }
+
+ private:
+  Index sentinel(List list) const { return static_cast<Index>(capacity_ + list); }
+
+ private:
+  size_t capacity_;                    // 普通节点数
+  std::unique_ptr<Node[]> nodes_;    // 节点数组，末尾为各链表的虚拟节点
+  size_t count_[kLists];            // 各链表条目数
+
+ public:
+// 删除拷贝语义
+  IndexList(const IndexList &other) = delete;
+  IndexList &operator=(const IndexList &other) = delete;
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_INDEXLIST_H_
@@ -0,0 +1,125 @@
+/**
+  ******************************************************************************
+  * @file           : InlineTask.h
+  * @author         : xy
+  * @brief          : 定长内联存储的无参任务，工作线程任务队列的槽位类型
+  * @attention      : 只能移动不能拷贝；超出内联容量的可调用对象退回堆上分配
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_INLINETASK_H_
+#define CACHE_SRC_CACHE_INLINETASK_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Cache {
+
+/**
+ * @brief 代替 std::function<void()>：可调用对象直接构造在任务自带的 kCapacity 字节缓冲区中，
+ * 环形队列的槽位在构造时一次分配，投递任务不再分配内存。std::function 的小对象缓冲区只有两个指针大小，
+ * 捕获了 key、value 的 put、multiPut 与 getAsync 任务都放不下，每次投递都要分配一次。
+ * 大于 kCapacity 或移动构造可能抛异常的可调用对象（例如捕获了很大的 getAsync 回调）仍在堆上分配
+ */
+class InlineTask {
+ public:
+  static constexpr size_t kCapacity = 112;    // 与操作表指针合计 128 字节，两个缓存行
+
+  InlineTask() = default;
+
+  InlineTask(std::nullptr_t) {}
+
+  template<typename F, typename Fn = std::decay_t<F>,
+	  typename = std::enable_if_t<!std::is_same_v<Fn, InlineTask> && !std::is_same_v<Fn, std::nullptr_t>>>
+  InlineTask(F &&f) {
+	  if constexpr (kInline<Fn>) {
+		  new(buffer_) Fn(std::forward<F>(f));
+		  ops_ = &InlineOps<Fn>::kOps;
+	  } else {
+		  new(buffer_) Fn *(new Fn(std::forward<F>(f)));
+		  ops_ = &HeapOps<Fn>::kOps;
+	  }
+  }
+
+  InlineTask(InlineTask &&other) noexcept { moveFrom(other); }
+
+  InlineTask &operator=(InlineTask &&other) noexcept {
+	  if (this != &other) {
+		  reset();
+		  moveFrom(other);
+	  }
+	  return *this;
+  }
+
+  InlineTask &operator=(std::nullptr_t) noexcept {
+	  reset();
+	  return *this;
+  }
+
+  ~InlineTask() { reset(); }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+  void operator()() { ops_->invoke(buffer_); }
+
+ private:
+  struct Ops {
+	  void (*invoke)(void *);
+	  void (*move)(void *dst, void *src);    // 移动到 dst 并析构 src
+	  void (*destroy)(void *);
+  };
+
+  template<typename Fn>
+  static constexpr bool kInline = sizeof(Fn) <= kCapacity && alignof(Fn) <= alignof(std::max_align_t)
+	  && std::is_nothrow_move_constructible_v<Fn>;
+
+  template<typename Fn>
+  struct InlineOps {
+	  static void invoke(void *p) { (*static_cast<Fn *>(p))(); }
+	  static void move(void *dst, void *src) {
+		  new(dst) Fn(std::move(*static_cast<Fn *>(src)));
+		  static_cast<Fn *>(src)->~Fn();
+	  }
+	  static void destroy(void *p) { static_cast<Fn *>(p)->~Fn(); }
+	  static constexpr Ops kOps{invoke, move, destroy};
+  };
+
+  // 缓冲区中只存指向堆上对象的指针
+  template<typename Fn>
+  struct HeapOps {
+	  static void invoke(void *p) { (**static_cast<Fn **>(p))(); }
+	  static void move(void *dst, void *src) { new(dst) Fn *(*static_cast<Fn **>(src)); }
+	  static void destroy(void *p) { delete *static_cast<Fn **>(p); }
+	  static constexpr Ops kOps{invoke, move, destroy};
+  };
+
+  void reset() {
+	  if (ops_ != nullptr) {
+		  ops_->destroy(buffer_);
+		  ops_ = nullptr;
+	  }
+  }
+
+  void moveFrom(InlineTask &other) {
+	  if (other.ops_ != nullptr) {
+		  other.ops_->move(buffer_, other.buffer_);
+		  ops_ = std::exchange(other.ops_, nullptr);
+	  }
+  }
+
+ private:
+  alignas(std::max_align_t) unsigned char buffer_[kCapacity];
+  const Ops *ops_ = nullptr;    // 为空表示没有任务
+
+ public:
+// 删除拷贝语义
+  InlineTask(const InlineTask &other) = delete;
+  InlineTask &operator=(const InlineTask &other) = delete;
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_INLINETASK_H_
@@ -12,30 +12,41 @@
 #define CACHE_SRC_CACHE_LFU_H_
 
 #include <memory>
+#include <chrono>
 #include <unordered_map>
 #include <cmath>
 #include <mutex>
+#include <vector>
 #include <algorithm>
 
 #include "CachePolicy.h"
+#include "FlatMap.h"
+#include "ChangeSet.h"
+#include "CacheWeigher.h"
+#include "TimingWheel.h"
 
 namespace Cache {
 
-template<typename Key, typename Value>
+template<typename Key, typename Value, typename Weigher = UnitWeigher<Key, Value>>
 class LFU;
 template<typename Key, typename Value>
 class FreqList;
 template<typename Key, typename Value>
 class LFUCache;
+template<typename Key, typename Value>
+class MultiLFU;
 
+// 继承 TimerHook，设置过期时间的节点直接挂到时间轮上
 template<typename Key, typename Value>
-class LfuNode {
-  friend class LFU<Key, Value>;
+class LfuNode : public TimerHook {
+  template<typename K, typename V, typename W> friend
+  class LFU;
   friend class FreqList<Key, Value>;
   friend class LFUCache<Key, Value>;
+  friend class MultiLFU<Key, Value>;
  public:
   LfuNode(Key key, Value value)
-	  : key_(key), value_(value), count_(1), prev_(nullptr), next_(nullptr) {}
+	  : key_(std::move(key)), value_(std::move(value)), count_(1), weight_(1), version_(0), prev_(nullptr), next_(nullptr) {}
 
   ~LfuNode() {
 	  prev_ = nullptr;
@@ -46,16 +57,21 @@ class LfuNode {
   Key key_;
   Value value_;
   size_t count_;    // 缓存被访问次数
+  size_t weight_;    // 条目权重，淘汰时从总权重中扣除
+  uint64_t version_;    // 最后一次写入的版本号，只用于多线程缓存之间同步时判断新旧
   std::shared_ptr<LfuNode<Key, Value>> prev_;
   std::shared_ptr<LfuNode<Key, Value>> next_;
 };
 
+// 同一访问频次的节点链表；各频率链表再按频次从小到大串成一条链表，最小频次永远是第一条
 template<typename Key, typename Value>
 class FreqList {
+  template<typename K, typename V, typename W> friend
+  class LFU;
   using NodeType = LfuNode<Key, Value>;
   using NodePtr = std::shared_ptr<NodeType>;
  public:
-  explicit FreqList(size_t n) : freq_(n) { init(); }
+  explicit FreqList(size_t n) : freq_(n), prevList_(nullptr), nextList_(nullptr) { init(); }
 
   ~FreqList() {
 	  dummyHead_->next_ = nullptr;
@@ -107,27 +123,37 @@ class FreqList {
   size_t freq_;    // 频率
   NodePtr dummyHead_;
   NodePtr dummyTail_;
+  FreqList *prevList_;    // 频次更小的相邻链表
+  FreqList *nextList_;    // 频次更大的相邻链表
 };
 
-template<typename Key, typename Value>
-class MultiLFU;
-
-template<typename Key, typename Value>
+/**
+ * @brief capacity 为权重之和的上限，默认每个条目权重为 1，即条目数上限；
+ * 传入按字节计算的 Weigher 时 capacity 即为字节预算，插入时连续淘汰最小频次节点直到新条目放得下
+ * @tparam Key
+ * @tparam Value
+ * @tparam Weigher 形如 size_t(const Key &, const Value &)
+ */
+template<typename Key, typename Value, typename Weigher>
 class LFU : public CachePolicy<Key, Value> {
   friend class LFUCache<Key, Value>;
   friend class MultiLFU<Key, Value>;
 
   using NodeType = LfuNode<Key, Value>;
   using NodePtr = std::shared_ptr<NodeType>;
-  using NodeMap = std::unordered_map<Key, NodePtr>;
-  using FreqListMap = std::unordered_map<int, std::shared_ptr<FreqList<Key, Value>>>;
+  using NodeMap = FlatMap<Key, NodePtr>;
+  using FreqListMap = std::unordered_map<size_t, std::shared_ptr<FreqList<Key, Value>>>;
  public:
-  explicit LFU(size_t capacity = 1, int maxAverageNum = 10)
+  explicit LFU(size_t capacity = 1, int maxAverageNum = 10, Weigher weigher = Weigher())
 	  : capacity_(capacity)
-		, minFreq_(1)
+		, totalWeight_(0)
+		, weigher_(std::move(weigher))
 		, maxAverageNum_(maxAverageNum)
 		, curAverageNum_(0)
-		, curTotalNum_(0) {
+		, curTotalNum_(0)
+		, agingOffset_(0)
+		, minList_(nullptr)
+		, entryList_(nullptr) {
 
   }
 
@@ -136,69 +162,209 @@ class LFU : public CachePolicy<Key, Value> {
 	  freqToFreqList_.clear();
   }
 
+  // 不带过期时间的写入，已有的过期时间会被清除
   void put(Key key, Value value) override {
+	  tick();
+	  if (auto node = insert(std::move(key), std::move(value))) {
+		  wheel_.cancel(node);
+	  }
+  }
+
+  // 写入后经过 ttl 过期，过期的条目不会再被读到，由之后的写入及按采样节奏的未命中读取回收
+  void put(Key key, Value value, std::chrono::nanoseconds ttl) {
+	  tick();
+	  if (auto node = insert(std::move(key), std::move(value))) {
+		  wheel_.schedule(node, ttl);
+	  }
+  }
+
+  std::optional<Value> get(const Key &key) override {
+	  return lookup(key);
+  }
+
+  // 异构查找，例如 Key 为 std::string 时可以直接用 std::string_view 查找
+  template<typename K>
+  std::optional<Value> get(const K &key) {
+	  return lookup(key);
+  }
+
+  // 只读取值，不改变淘汰顺序，也不计入访问次数
+  std::optional<Value> peek(const Key &key) const {
 	  auto it = nodeMap_.find(key);
-	  if (it != nodeMap_.end()) {
-		  it->second->value_ = value;
-		  updateNode(it->second);
-		  return;
+	  // 只读访问不推进时间轮，设置了过期时间的条目直接按时钟判断
+	  if (it == nodeMap_.end() || (it->second->scheduled() && it->second->expired(wheel_.current()))) {
+		  return std::nullopt;
 	  }
-	  putNode(key, value);
+	  return it->second->value_;
   }
 
-  std::optional<Value> get(Key key) override {
+  // 距过期还剩多久，条目不存在或没有设置过期时间时为空
+  std::optional<std::chrono::nanoseconds> ttl(const Key &key) const {
+	  auto it = nodeMap_.find(key);
+	  if (it == nodeMap_.end() || !it->second->scheduled()) {
+		  return std::nullopt;
+	  }
+	  return wheel_.remaining(it->second.get());
+  }
+
+  size_t size() const { return nodeMap_.size(); }
+
+  // 设置了过期时间且尚未回收的条目数
+  size_t expiringSize() const { return wheel_.size(); }
+
+  // 当前所有条目的权重之和，不超过 capacity
+  size_t totalWeight() const { return totalWeight_; }
+
+  size_t capacity() const { return capacity_; }
+
+  // 每个条目除 key、value 之外的内存开销估算：节点中的指针、频次与权重，make_shared 控制块，
+  // 索引槽位（key 副本与节点指针）及其控制字节，未计入频率链表头和哈希表的空闲槽位
+  static constexpr size_t nodeOverhead() {
+	  return sizeof(NodeType) - sizeof(Key) - sizeof(Value) + kSharedBlockOverhead
+		  + sizeof(typename NodeMap::value_type) + 1;
+  }
+
+ private:
+  template<typename K>
+  std::optional<Value> lookup(const K &key) {
 	  auto it = nodeMap_.find(key);
 	  if (it != nodeMap_.end()) {
+		  // 命中不推进时间轮：没有过期时间的条目只判断一次，设置了过期时间的条目才按时钟判断，
+		  // 已过期但还没轮到回收的按未命中处理，顺便回收
+		  if (it->second->scheduled() && it->second->expired(wheel_.current())) {
+			  eraseNode(it->second);
+			  return std::nullopt;
+		  }
 		  updateNode(it->second);
 		  return it->second->value_;
 	  }
+	  tick(true);
 	  return std::nullopt;
   }
 
- private:
-  void putNode(Key key, Value value) {
-	  // 判断缓存是否已满
-	  if (nodeMap_.size() == capacity_) {
-		  removeMinFreqNode();
+  // 写入或更新节点，返回写入后的节点，放不下时返回 nullptr
+  NodeType *insert(Key key, Value value) {
+	  auto weight = weigher_(key, value);
+	  auto it = nodeMap_.find(key);
+	  // 单个条目超过整个容量，放不下，旧值也不再有效
+	  if (weight > capacity_) {
+		  if (it != nodeMap_.end()) {
+			  eraseNode(it->second);
+		  }
+		  return nullptr;
+	  }
+	  if (it != nodeMap_.end()) {
+		  auto node = it->second;
+		  totalWeight_ = totalWeight_ - node->weight_ + weight;
+		  node->weight_ = weight;
+		  node->value_ = std::move(value);
+		  updateNode(node);
+		  // 新值变大时可能超出容量，节点自己也可能被淘汰
+		  if (totalWeight_ > capacity_) {
+			  while (totalWeight_ > capacity_ && removeMinFreqNode()) {}
+			  if (nodeMap_.find(node->key_) == nodeMap_.end()) {
+				  return nullptr;
+			  }
+		  }
+		  return node.get();
 	  }
-	  NodePtr node = std::make_shared<NodeType>(key, value);
-	  nodeMap_[key] = node;
-	  addToFreqList(node);
+	  return putNode(std::move(key), std::move(value), weight);
+  }
+
+  // 协作式推进时间轮，没有设置过期时间的条目时只有一次判断；sampled 为 true 时按采样节奏推进，用于读路径
+  void tick(bool sampled = false) {
+	  if (wheel_.empty() || (sampled && !wheel_.sample())) {
+		  return;
+	  }
+	  wheel_.advance([this](NodeType *node) {
+		auto it = nodeMap_.find(node->key_);
+		if (it != nodeMap_.end()) {
+			eraseNode(it->second);
+		}
+	  });
+  }
+
+  NodeType *putNode(Key key, Value value, size_t weight) {
+	  // 容量不足时连续淘汰，直到新节点放得下
+	  while (totalWeight_ + weight > capacity_ && removeMinFreqNode()) {}
+	  NodePtr node = std::make_shared<NodeType>(key, std::move(value));
+	  node->weight_ = weight;
+	  totalWeight_ += weight;
+	  // 新节点的有效频次为 1，存储的是叠加了老化偏移量的原始频次
+	  node->count_ = agingOffset_ + 1;
+	  nodeMap_.emplace(std::move(key), node);
+	  // entryList_ 是原始频次不超过 agingOffset_ + 1 的最后一条链表，新节点的链表就是它或紧跟在它之后
+	  if (entryList_ == nullptr || entryList_->freq_ != node->count_) {
+		  entryList_ = createFreqList(node->count_, entryList_);
+	  }
+	  entryList_->insertNode(node);
 	  addFreqNum();
-	  minFreq_ = 1;
+	  return node.get();
   }
 
   void updateNode(NodePtr node) {
-	  // 频率更新，从当前频率链表中移除，并加入新的频率链表
+	  // 频率加一：目标链表就是当前链表的下一条，不存在则紧跟在当前链表之后创建，再从当前链表移除
+	  auto cur = freqToFreqList_.find(node->count_)->second.get();
+	  auto next = cur->nextList_;
+	  if (next == nullptr || next->freq_ != node->count_ + 1) {
+		  next = createFreqList(node->count_ + 1, cur);
+	  }
 	  removeFromFreqList(node);
 	  node->count_++;
-	  addToFreqList(node);
+	  next->insertNode(node);
+  }
 
-	  // 由于有从某个频率的链表中删除节点，可能导致链表为空
-	  // 有可能导致最小频率的链表为空，需要更新最小频率
-	  auto prevCount = node->count_ - 1;
-	  if (prevCount == minFreq_ && freqToFreqList_[prevCount]->isEmpty()) {
-		  minFreq_++;
-	  }
+  // 最小频次链表就是第一条链表，淘汰与过期删除都会在链表为空时把它摘掉，不需要扫描
+  bool removeMinFreqNode() {
+	  if (minList_ == nullptr) { return false; }
+	  auto node = minList_->getFirstNode();
+	  removeFromFreqList(node);
+	  wheel_.cancel(node.get());
+	  nodeMap_.erase(node->key_);
+	  totalWeight_ -= node->weight_;
+	  return true;
   }
 
-  void removeMinFreqNode() {
-	  auto node = freqToFreqList_[minFreq_]->getFirstNode();
+  void eraseNode(NodePtr node) {
 	  removeFromFreqList(node);
+	  wheel_.cancel(node.get());
 	  nodeMap_.erase(node->key_);
+	  totalWeight_ -= node->weight_;
   }
 
   void removeFromFreqList(NodePtr node) {
-	  auto count = node->count_;
-	  freqToFreqList_[count]->removeNode(node);
+	  auto it = freqToFreqList_.find(node->count_);
+	  if (it == freqToFreqList_.end()) { return; }
+	  auto list = it->second.get();
+	  list->removeNode(node);
+	  // 回收空链表，避免频率链表数量无限增长
+	  if (list->isEmpty()) {
+		  (list->prevList_ ? list->prevList_->nextList_ : minList_) = list->nextList_;
+		  if (list->nextList_) {
+			  list->nextList_->prevList_ = list->prevList_;
+		  }
+		  if (entryList_ == list) {
+			  entryList_ = list->prevList_;
+		  }
+		  freqToFreqList_.erase(it);
+	  }
   }
 
-  void addToFreqList(NodePtr node) {
-	  auto count = node->count_;
-	  if (freqToFreqList_.find(count) == freqToFreqList_.end()) {
-		  freqToFreqList_[count] = std::make_shared<FreqList<Key, Value>>(count);
+  // 创建频次为 count 的空链表，插入到 prev 之后，prev 为 nullptr 时成为第一条
+  FreqList<Key, Value> *createFreqList(size_t count, FreqList<Key, Value> *prev) {
+	  auto owner = std::make_shared<FreqList<Key, Value>>(count);
+	  auto list = owner.get();
+	  freqToFreqList_.emplace(count, std::move(owner));
+	  list->prevList_ = prev;
+	  list->nextList_ = prev ? prev->nextList_ : minList_;
+	  (prev ? prev->nextList_ : minList_) = list;
+	  if (list->nextList_) {
+		  list->nextList_->prevList_ = list;
+	  }
+	  if (count <= agingOffset_ + 1 && (entryList_ == nullptr || count > entryList_->freq_)) {
+		  entryList_ = list;
 	  }
-	  freqToFreqList_[count]->insertNode(node);
+	  return list;
   }
 
   void addFreqNum() {
@@ -213,70 +379,95 @@ class LFU : public CachePolicy<Key, Value> {
 	  }
   }
 
+  /**
+   * @brief 所有节点频率减去 maxAverageNum_ / 2
+   * 不再遍历 nodeMap_ 重建频率链表，而是累加到全局老化偏移量 agingOffset_：
+   * 节点存储原始频次，有效频次为 max(1, count_ - agingOffset_)，新节点从 agingOffset_ + 1 开始计数。
+   * 老化只改变有效频次，不改变原始频次之间的相对顺序，所以各频率链表及其顺序都不需要调整，
+   * 有效频次被压到 1 的老节点仍按原始频次先于新节点淘汰
+   */
   void handleOverMaxAverageNum() {
 	  if (nodeMap_.empty()) { return; }
 
-	  // 所有节点频率减半，重新加入到新的频率链表中
-	  for (auto &nodeItm : nodeMap_) {
-		  if (nodeItm.second == nullptr) { continue; }
-
-		  auto node = nodeItm.second;
-
-		  // 先移除
-		  removeFromFreqList(node);
-
-		  // 频率减半
-		  node->count_ -= maxAverageNum_ / 2;
-		  if (node->count_ < 1) { node->count_ = 1; }
-
-		  // 更新之后，加入到频率链表中
-		  addToFreqList(node);
-	  }
-
-	  // 更新最小频率
-	  updateMinFreq();
-  }
-
-  void updateMinFreq() {
-	  minFreq_ = INT8_MAX;
-	  for (const auto &freqItm : freqToFreqList_) {
-		  if (freqItm.second && !freqItm.second->isEmpty()) {
-			  minFreq_ = std::min(minFreq_, freqItm.first);
-		  }
-	  }
-	  if (minFreq_ == INT8_MAX) {
-		  minFreq_ = 1;
+	  auto decay = maxAverageNum_ / 2;
+	  agingOffset_ += decay;
+	  // 新节点的频次变大，entryList_ 向后移动；跨过的链表频次各不相同且不超过 decay 个，均摊 O(1)
+	  for (auto next = entryList_ ? entryList_->nextList_ : minList_;
+		   next != nullptr && next->freq_ <= agingOffset_ + 1; next = next->nextList_) {
+		  entryList_ = next;
 	  }
+	  // 总访问频次同步减少，否则之后每次 put 都会再次触发老化
+	  curTotalNum_ -= std::min(curTotalNum_, decay * nodeMap_.size());
+	  curAverageNum_ = curTotalNum_ / nodeMap_.size();
   }
 
   NodeMap &nodeMap() { return nodeMap_; }
 
  private:
-  size_t capacity_;        // 缓存容量
-  int minFreq_;        // 最小访问频次
+  size_t capacity_;        // 缓存容量（权重之和的上限）
+  size_t totalWeight_;    // 当前权重之和
+  Weigher weigher_;        // 计算条目权重
+  TimingWheel<NodeType> wheel_;    // 设置了过期时间的节点
   size_t maxAverageNum_;    // 最大平均访问频次
   size_t curAverageNum_;    // 当前平均访问频次
   size_t curTotalNum_;    // 当前总访问频次
+  size_t agingOffset_;    // 累计老化量，原始频次减去它为有效频次
   NodeMap nodeMap_;
   FreqListMap freqToFreqList_;    // key 为访问频次，value 为对应的链表，记录着相同访问频次的节点
+  FreqList<Key, Value> *minList_;    // 频次最小的链表，按频次有序串联的第一条
+  FreqList<Key, Value> *entryList_;    // 原始频次不超过 agingOffset_ + 1 的最后一条链表，新节点从这里插入
 };
 
 template<typename Key, typename Value>
 class MultiLFU {
   using LFUptr = std::shared_ptr<LFU<Key, Value>>;
-  using PNodeMap = std::unordered_map<Key, std::shared_ptr<LfuNode<Key, Value>>>;
  public:
-  explicit MultiLFU(size_t capacity = 1)
-	  : cache_(std::make_shared<LFU<Key, Value>>(capacity)), pending_(std::make_shared<LFU<Key, Value>>(capacity)) {}
+  using Entry = ChangeEntry<Key, Value>;
+
+  // trackChanges 为 false 时不记录脏 key，用于不需要同步的哈希路由
+  explicit MultiLFU(size_t capacity = 1, bool trackChanges = true)
+	  : cache_(std::make_shared<LFU<Key, Value>>(capacity)) {
+	  if (trackChanges) {
+		  changes_ = std::make_unique<ChangeSet<Key, Value>>(capacity);
+	  }
+  }
 
   ~MultiLFU() = default;
 
-  void put(Key key, Value value) {
-	  cache_->put(key, value);
-	  pending_->put(key, value);
+  /**
+   * @brief 写入并记为本分片的脏 key。版本号在调用方线程分配后才投递，投递可能晚于同步：
+   * 本分片已有同步来的更新版本时跳过，否则本分片留下旧值，其它分片又因版本更新而跳过它，各分片永久不一致
+   * @param version 写入的版本号，由管理者在调用方线程统一分配，所有分片共用一个计数；不记录脏 key 时忽略
+   */
+  void put(Key key, Value value, uint64_t version) {
+	  if (!changes_) {
+		  cache_->put(std::move(key), std::move(value));
+		  return;
+	  }
+	  if (stale(key, version)) {
+		  return;
+	  }
+	  // 先写入缓存再记录：记录时可能清理已被淘汰的 key，此时本次写入的 key 必须已在缓存中
+	  cache_->put(key, std::move(value));
+	  stamp(key, version);
+	  changes_->mark(key, version, [this](const Key &k) { return cache_->peek(k); });
+  }
+
+  // 带过期时间的写入，同步到其它分片时一并带上剩余的过期时间
+  void put(Key key, Value value, std::chrono::nanoseconds ttl, uint64_t version) {
+	  if (!changes_) {
+		  cache_->put(std::move(key), std::move(value), ttl);
+		  return;
+	  }
+	  if (stale(key, version)) {
+		  return;
+	  }
+	  cache_->put(key, std::move(value), ttl);
+	  stamp(key, version);
+	  changes_->mark(key, version, [this](const Key &k) { return cache_->peek(k); });
   }
 
-  std::optional<Value> get(Key key) {
+  std::optional<Value> get(const Key &key) {
 	  return cache_->get(key);
   }
 
@@ -284,22 +475,57 @@ class MultiLFU {
 	  return cache_->get(key, value);
   }
 
-  PNodeMap &pending(bool isSwap = true) {
-	  if (isSwap) {
-		  swap();
+  // 取走本分片自上次同步以来写过且仍在缓存中的 key 及其当前值，未开启记录时为空
+  std::vector<Entry> drainChanges() {
+	  if (!changes_) {
+		  return {};
+	  }
+	  auto entries = changes_->drain([this](const Key &key) { return cache_->peek(key); });
+	  // 其它分片按剩余时间设置过期，副本与本分片的条目同时过期
+	  for (auto &entry : entries) {
+		  entry.ttl_ = cache_->ttl(entry.key_);
 	  }
-	  return pending_->nodeMap();
+	  return entries;
   }
 
-  void swap() {        // 得加锁
-	  std::lock_guard<std::mutex> _lock(mutex_);
-	  std::swap(cache_, pending_);
+  /**
+   * @brief 应用其它分片的变更：只写缓存，不记为本分片的脏 key。
+   * 本分片已有版本号不小于它的写入时跳过，同一个 key 在多个分片上写过时各分片都保留版本号最大的值，
+   * 同一批变更重复投递也不会重复写入
+   * @param entries 一批变更，顺序不限
+   */
+  void apply(const std::vector<Entry> &entries) {
+	  for (const auto &entry : entries) {
+		  if (stale(entry.key_, entry.version_)) {
+			  continue;
+		  }
+		  if (entry.ttl_) {
+			  cache_->put(entry.key_, entry.value_, *entry.ttl_);
+		  } else {
+			  cache_->put(entry.key_, entry.value_);
+		  }
+		  stamp(entry.key_, entry.version_);
+	  }
+  }
+
+ private:
+  // 本分片已有版本号不小于 version 的写入
+  bool stale(const Key &key, uint64_t version) {
+	  auto it = cache_->nodeMap_.find(key);
+	  return it != cache_->nodeMap_.end() && it->second->version_ >= version;
+  }
+
+  // 记录条目当前值的版本号，条目放不下被丢弃时什么也不做
+  void stamp(const Key &key, uint64_t version) {
+	  auto it = cache_->nodeMap_.find(key);
+	  if (it != cache_->nodeMap_.end()) {
+		  it->second->version_ = version;
+	  }
   }
 
  private:
   LFUptr cache_;           // 对外提供服务的缓存
-  LFUptr pending_;        // 增量缓存
-  std::mutex mutex_;
+  std::unique_ptr<ChangeSet<Key, Value>> changes_;    // 本分片的脏 key
 };
 
 }
@@ -11,27 +11,31 @@
 #ifndef CACHE_SRC_CACHE_LFUCACHE_H_
 #define CACHE_SRC_CACHE_LFUCACHE_H_
 
-#include <iostream>
 #include <thread>
-#include <queue>
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <future>
 #include <functional>
+#include <vector>
 
 #include "LFU.h"
+#include "MPSCQueue.h"
+#include "InlineTask.h"
+#include "CacheRoute.h"
 
 namespace Cache{
 
 template<typename Key, typename Value>
 class LFUThread {
-  using Task = std::function<void()>;
+  using Task = InlineTask;    // 任务直接存放在环形队列的槽位中，投递时不分配内存
+  static constexpr int kSpinCount = 64;    // 挂起前的自旋次数
   using LFUptr = std::shared_ptr<LFU<Key, Value>>;
-  using PNodeMap = std::unordered_map<Key, std::shared_ptr<LfuNode<Key, Value>>>;
+  using Entry = ChangeEntry<Key, Value>;
  public:
-  LFUThread(size_t capacity, size_t id_)
-	  : id_(id_), cache_(std::make_shared<MultiLFU<Key, Value>>(capacity)) {
+  // trackChanges 为 false 时不记录脏 key，用于不需要同步的哈希路由
+  LFUThread(size_t capacity, size_t id_, bool trackChanges = true)
+	  : id_(id_), cache_(std::make_shared<MultiLFU<Key, Value>>(capacity, trackChanges)) {
 	  startThread();
   }
 
@@ -51,49 +55,104 @@ class LFUThread {
 		  std::bind(std::forward<F>(f), std::forward<Args>(args)...));
 
 	  std::future<RetType> ret = task->get_future();
-	  {
-		  std::lock_guard<std::mutex> lock(queueMutex_);
-		  tasks_.emplace([task] { (*task)(); });
-	  }
-	  condition_.notify_one();
+	  post([task] { (*task)(); });
 	  return ret;
   }
 
-  void put(Key key, Value value) {
-	  cache_->put(key, value);
+  // 提交不需要返回值的任务，不经过 packaged_task 和 future
+  void post(Task task) {
+	  // 在本线程的任务中（例如 getAsync 的回调）再次提交时直接执行：
+	  // 否则 commit 等待只有本线程能完成的 future、队列满时等待本线程消费，都会永远阻塞
+	  if (inWorker()) {
+		  task();
+		  return;
+	  }
+	  // 无锁入队，队列满时让出 CPU 等待工作线程消费
+	  while (!tasks_.tryPush(std::move(task))) {
+		  if (isStop_.load()) {
+			  return;
+		  }
+		  std::this_thread::yield();
+	  }
+	  if (isStop_.load()) {
+		  return;
+	  }
+	  // 与工作线程置 sleeping_ 后检查队列的顺序配对，保证不会漏掉唤醒
+	  std::atomic_thread_fence(std::memory_order_seq_cst);
+	  // 工作线程醒着时一定会看到新任务，只有它挂起时才需要唤醒
+	  if (sleeping_.load(std::memory_order_relaxed)) {
+		  std::lock_guard<std::mutex> lock(parkMutex_);
+		  condition_.notify_one();
+	  }
+  }
+
+  void put(Key key, Value value, uint64_t version) {
+	  cache_->put(std::move(key), std::move(value), version);
+  }
+
+  void put(Key key, Value value, std::chrono::nanoseconds ttl, uint64_t version) {
+	  cache_->put(std::move(key), std::move(value), ttl, version);
   }
 
-  std::optional<Value> get(Key key) {
+  std::optional<Value> get(const Key &key) {
 	  return cache_->get(key);
   }
 
   bool get(Key key, Value &value) {
 	  return cache_->get(key, value);
   }
-  PNodeMap &pending() {
-	  return cache_->pending();
+  // 以下两个方法只能在本线程的任务中调用
+  std::vector<Entry> drainChanges() {
+	  return cache_->drainChanges();
   }
 
+  void apply(const std::vector<Entry> &entries) {
+	  cache_->apply(entries);
+  }
+
+  size_t id() const { return id_; }
+
+  // 是否在本线程的工作线程上调用；worker_ 在构造时赋值，之后只读
+  bool inWorker() const { return std::this_thread::get_id() == worker_.get_id(); }
+
  private:
   void startThread() {
 	  worker_ = std::thread([this] {
+		Task task;
 		while (!isStop_.load()) {
-			std::unique_lock<std::mutex> uq_lock(queueMutex_);
-			condition_.wait(uq_lock, [this]() {
-			  return !tasks_.empty() || isStop_.load();
-			});
-			if (!tasks_.empty()) {
-				auto task = tasks_.front();
-				tasks_.pop();
-				uq_lock.unlock();
+			if (tasks_.tryPop(task) || spinPop(task)) {
 				task();
+				task = nullptr;
+				continue;
 			}
+			// 自旋后仍然没有任务，挂起等待生产者唤醒
+			std::unique_lock<std::mutex> lock(parkMutex_);
+			sleeping_.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			condition_.wait(lock, [this]() {
+			  return !tasks_.empty() || isStop_.load();
+			});
+			sleeping_.store(false, std::memory_order_relaxed);
 		}
 	  });
   }
 
+  // 挂起前先短暂自旋，任务密集时避免频繁的睡眠与唤醒
+  bool spinPop(Task &task) {
+	  for (int i = 0; i < kSpinCount; ++i) {
+		  if (tasks_.tryPop(task)) {
+			  return true;
+		  }
+		  std::this_thread::yield();
+	  }
+	  return false;
+  }
+
   void stopThread() {
-	  isStop_ = true;
+	  {
+		  std::lock_guard<std::mutex> lock(parkMutex_);
+		  isStop_ = true;
+	  }
 	  condition_.notify_one();
 	  if (worker_.joinable()) {
 		  worker_.join();
@@ -103,79 +162,192 @@ class LFUThread {
  private:
   size_t id_;
   std::shared_ptr<MultiLFU<Key, Value>> cache_;
-  std::queue<Task> tasks_;
+  MPSCQueue<Task> tasks_;                // 无锁任务队列，多个调用方线程写、工作线程读
   std::thread worker_;
   std::condition_variable condition_;
-  std::mutex queueMutex_;
+  std::mutex parkMutex_;                 // 只在工作线程挂起和唤醒时使用
+  std::atomic<bool> sleeping_ = false;   // 工作线程是否已挂起
   std::atomic<bool> isStop_ = false;
 };
 
 template<typename Key, typename Value>
 class LFUCache {
-  using PNodeMap = std::unordered_map<Key, std::shared_ptr<LfuNode<Key, Value>>>;
+  using Entry = ChangeEntry<Key, Value>;
  public:
-  LFUCache(size_t capacity, size_t threadNum, size_t syncInterval = 3)
-	  : index_(0), isSyncing_(true),
-	  threadNum_(threadNum),
-	  mainCache_(std::make_shared<MultiLFU<Key, Value>>(capacity)) {
+  LFUCache(size_t capacity, size_t threadNum, size_t syncInterval = 3, RouteMode mode = RouteMode::RoundRobin)
+	  : index_(0), version_(0), threadNum_(threadNum), isSyncing_(true), mode_(mode) {
 	  for (size_t i = 0; i < threadNum_; ++i) {
-		  threads_.push_back(std::make_shared<LFUThread<Key, Value>>(capacity, i));
+		  threads_.push_back(std::make_shared<LFUThread<Key, Value>>(capacity, i, mode_ == RouteMode::RoundRobin));
 	  }
 
+	  // 按哈希路由时每个 key 只存在于一个线程，不需要同步
+	  if (mode_ == RouteMode::HashAffinity) {
+		  return;
+	  }
 	  // 开启定时同步
 	  syncThread_ = std::thread([this, syncInterval]() {
-		while (isSyncing_) {
-			std::this_thread::sleep_for(std::chrono::seconds(syncInterval));
+		// 用条件变量代替 sleep，析构时可以立即唤醒退出，不必等满一个同步周期
+		std::unique_lock<std::mutex> lock(syncMutex_);
+		while (!syncCond_.wait_for(lock, std::chrono::seconds(syncInterval), [this] { return !isSyncing_.load(); })) {
 			syncCache();
 		}
 	  });
   }
 
   ~LFUCache() {
-	  isSyncing_ = false;
+	  {
+		  std::lock_guard<std::mutex> lock(syncMutex_);
+		  isSyncing_ = false;
+	  }
+	  syncCond_.notify_one();
 	  if (syncThread_.joinable()) {
 		  syncThread_.join();
 	  }
   }
 
   void put(Key key, Value value, size_t index) {
-	  checkIndex(index);
-	  threads_[index]->commit([this, index, key, value]() {
-		threads_[index]->put(key, value);
+	  index = route(key, index);
+	  auto version = nextVersion();
+	  threads_[index]->post([this, index, key = std::move(key), value = std::move(value), version]() mutable {
+		threads_[index]->put(std::move(key), std::move(value), version);
 	  });
   }
 
-  std::optional<Value> get(Key key, size_t index) {
-	  checkIndex(index);
+  // 写入后经过 ttl 过期；轮询模式下同步时带上剩余的过期时间，其它线程中的副本同时过期
+  void put(Key key, Value value, std::chrono::nanoseconds ttl, size_t index) {
+	  index = route(key, index);
+	  auto version = nextVersion();
+	  threads_[index]->post([this, index, key = std::move(key), value = std::move(value), ttl, version]() mutable {
+		threads_[index]->put(std::move(key), std::move(value), ttl, version);
+	  });
+  }
+
+  std::optional<Value> get(const Key &key, size_t index) {
+	  index = route(key, index);
 	  auto future = threads_[index]->commit([this, index, key]() {
 		return threads_[index]->get(key);
 	  });
 	  return future.get();
   }
 
+  /**
+   * @brief 异步查询：查询在工作线程上执行，完成后由工作线程直接调用 callback，
+   * 调用方线程不阻塞，也不创建 future 和共享状态。callback 需要可拷贝，且不应长时间阻塞工作线程。
+   * callback 中可以再调用本缓存，落在同一个工作线程上的操作直接在 callback 中执行；
+   * 但落在其它工作线程上的 get、multiGet 会同步等待，两个工作线程的 callback 互相等待时会死锁
+   * @param callback 形如 void(std::optional<Value>)
+   */
+  template<typename Callback>
+  void getAsync(Key key, size_t index, Callback &&callback) {
+	  index = route(key, index);
+	  threads_[index]->post([this, index, key = std::move(key),
+							 callback = std::forward<Callback>(callback)]() mutable {
+		callback(threads_[index]->get(key));
+	  });
+  }
+
+  /**
+   * @brief 批量查询：整批 key 打包成一个任务提交给工作线程，只等待一次
+   * @param keys 待查询的 key
+   * 按哈希路由时，key 按归属线程分组，每个线程一个任务，各线程并行执行后统一等待
+   * @param index 指定的缓存线程
+   * @return 与 keys 一一对应的查询结果
+   */
+  std::vector<std::optional<Value>> multiGet(const std::vector<Key> &keys, size_t index) {
+	  if (mode_ == RouteMode::HashAffinity) {
+		  return multiGetByHash(keys);
+	  }
+	  checkIndex(index);
+	  std::vector<std::optional<Value>> results(keys.size());
+	  auto future = threads_[index]->commit([this, index, &keys, &results]() {
+		for (size_t i = 0; i < keys.size(); ++i) {
+			results[i] = threads_[index]->get(keys[i]);
+		}
+	  });
+	  future.get();
+	  return results;
+  }
+
+  // 批量写入：整批打包成一个任务，与 put 一样不等待执行结果
+  void multiPut(std::vector<std::pair<Key, Value>> items, size_t index) {
+	  if (mode_ == RouteMode::HashAffinity) {
+		  multiPutByHash(std::move(items));
+		  return;
+	  }
+	  checkIndex(index);
+	  // 整批一次分配连续的版本号，按批内顺序使用
+	  auto version = nextVersion(items.size());
+	  threads_[index]->post([this, index, items = std::move(items), version]() mutable {
+		for (auto &[key, value] : items) {
+			threads_[index]->put(std::move(key), std::move(value), version++);
+		}
+	  });
+  }
+
+  // 不指定线程：轮询模式下轮询选择，哈希模式下由 key 决定
+  void put(Key key, Value value) {
+	  put(std::move(key), std::move(value), threadNum_);
+  }
+
+  void put(Key key, Value value, std::chrono::nanoseconds ttl) {
+	  put(std::move(key), std::move(value), ttl, threadNum_);
+  }
+
+  std::optional<Value> get(const Key &key) {
+	  return get(key, threadNum_);
+  }
+
+  template<typename Callback>
+  void getAsync(Key key, Callback &&callback) {
+	  getAsync(std::move(key), threadNum_, std::forward<Callback>(callback));
+  }
+
+  std::vector<std::optional<Value>> multiGet(const std::vector<Key> &keys) {
+	  return multiGet(keys, threadNum_);
+  }
+
+  void multiPut(std::vector<std::pair<Key, Value>> items) {
+	  multiPut(std::move(items), threadNum_);
+  }
+
+  RouteMode mode() const { return mode_; }
+
   void checkIndex(size_t &index) {
 	  if (index >= threadNum_) {
 		  index = selectThread();
 	  }
   }
 
+  /**
+   * @brief 增量同步：每个分片在自己的工作线程上取出自上次同步以来写过的 key 及当前值，
+   * 再投递给其它分片的工作线程应用，工作量与两次同步之间写过的 key 数成正比，与缓存大小无关。
+   * 同一个 key 在多个分片上写过时，各分片都保留版本号最大（最后调用）的写入
+   */
   void syncCache() {
-	  // 防止特别同步时间太短，导致这边还在同步，就把容器交换，并发出现异常
+	  // 防止同步间隔过短，上一轮同步还未结束
 	  std::lock_guard<std::mutex> lock_guard(mtx_);
 
-	  // 收集所有子线程的 pending_ 缓存，合并到主缓存
-	  for (const auto &subCache : threads_) {
-		  const PNodeMap &pending = subCache->pending();
-		  for (const auto &[key, node] : pending) {
-			  mainCache_->put(node->key_, node->value_);
-		  }
+	  // 各分片并行取出变更，再统一等待
+	  std::vector<std::future<std::vector<Entry>>> futures;
+	  for (const auto &origin : threads_) {
+		  futures.push_back(origin->commit([origin = origin.get()]() {
+			return origin->drainChanges();
+		  }));
 	  }
-	  // 保证主缓存的一致性
-	  const PNodeMap &cache = mainCache_->pending(false);
-	  for (const auto &[key, node] : cache) {
-		  std::cout << "syncCache key: " << node->key_ << " value: " << node->value_ << std::endl;
-		  for (const auto &subCache : threads_) {
-			  subCache->put(node->key_, node->value_);
+	  for (size_t i = 0; i < threads_.size(); ++i) {
+		  auto entries = futures[i].get();
+		  if (entries.empty()) {
+			  continue;
+		  }
+		  // 同一批变更由多个分片共享，只读不拷贝
+		  auto batch = std::make_shared<const std::vector<Entry>>(std::move(entries));
+		  for (const auto &target : threads_) {
+			  if (target == threads_[i]) {
+				  continue;
+			  }
+			  target->post([target = target.get(), batch]() {
+				target->apply(*batch);
+			  });
 		  }
 	  }
   }
@@ -187,6 +359,68 @@ class LFUCache {
 	  return index_++ % threadNum_;
   }
 
+  /**
+   * @brief 分配 count 个连续的写入版本号，返回第一个。所有线程的缓存共用一个计数，在调用方线程分配，
+   * 同一个 key 后调用的写入版本号更大，同步时各线程都保留它的值；按哈希路由时不同步，不分配
+   */
+  uint64_t nextVersion(size_t count = 1) {
+	  if (mode_ == RouteMode::HashAffinity) {
+		  return 0;
+	  }
+	  return version_.fetch_add(count, std::memory_order_relaxed) + 1;
+  }
+
+  size_t route(const Key &key, size_t index) {
+	  if (mode_ == RouteMode::HashAffinity) {
+		  return routeOf(key, threadNum_);
+	  }
+	  checkIndex(index);
+	  return index;
+  }
+
+  std::vector<std::optional<Value>> multiGetByHash(const std::vector<Key> &keys) {
+	  // 记录每个线程负责的 key 在 keys 中的位置
+	  std::vector<std::vector<size_t>> groups(threadNum_);
+	  for (size_t i = 0; i < keys.size(); ++i) {
+		  groups[routeOf(keys[i], threadNum_)].push_back(i);
+	  }
+	  std::vector<std::optional<Value>> results(keys.size());
+	  std::vector<std::future<void>> futures;
+	  for (size_t index = 0; index < threadNum_; ++index) {
+		  if (groups[index].empty()) {
+			  continue;
+		  }
+		  // 每个任务只写自己负责的位置，互不重叠
+		  futures.push_back(threads_[index]->commit([this, index, &keys, &results, &group = groups[index]]() {
+			for (auto i : group) {
+				results[i] = threads_[index]->get(keys[i]);
+			}
+		  }));
+	  }
+	  for (auto &future : futures) {
+		  future.get();
+	  }
+	  return results;
+  }
+
+  void multiPutByHash(std::vector<std::pair<Key, Value>> items) {
+	  std::vector<std::vector<std::pair<Key, Value>>> groups(threadNum_);
+	  for (auto &item : items) {
+		  groups[routeOf(item.first, threadNum_)].push_back(std::move(item));
+	  }
+	  for (size_t index = 0; index < threadNum_; ++index) {
+		  if (groups[index].empty()) {
+			  continue;
+		  }
+		  threads_[index]->post([this, index, group = std::move(groups[index])]() mutable {
+			// 按哈希路由时不同步，不需要版本号
+			for (auto &[key, value] : group) {
+				threads_[index]->put(std::move(key), std::move(value), 0);
+			}
+		  });
+	  }
+  }
+
  public:
 // 删除拷贝语义
   LFUCache(const LFUCache &other) = delete;
@@ -196,12 +430,15 @@ class LFUCache {
   LFUCache &operator=(LFUCache &&other) = delete;
  private:
   std::atomic<size_t> index_;
+  std::atomic<uint64_t> version_;        // 已分配的最大写入版本号
   const size_t threadNum_;
   std::mutex mtx_;
   std::vector<std::shared_ptr<LFUThread<Key, Value>>> threads_;
   std::thread syncThread_;
   std::atomic<bool> isSyncing_;
-  std::shared_ptr<MultiLFU<Key, Value>> mainCache_;
+  const RouteMode mode_;
+  std::mutex syncMutex_;
+  std::condition_variable syncCond_;
 };
 }
 
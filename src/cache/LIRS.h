@@ -0,0 +1,319 @@
+/**
+  ******************************************************************************
+  * @file           : LIRS.h
+  * @author         : xy
+  * @brief          : LIRS 淘汰策略：LIR/HIR 栈 + 常驻 HIR 队列，按重用距离区分冷热
+  * @attention      : 不加锁；不常驻的 HIR 只保留 key，数量有上限，栈不会无限增长
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_LIRS_H_
+#define CACHE_SRC_CACHE_LIRS_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "CachePolicy.h"
+#include "FlatMap.h"
+
+namespace Cache {
+
+/**
+ * @brief 条目分为 LIR（重用距离短，约占容量 99%）与 HIR（约占 1%）。栈 S 按最近访问排列 LIR、常驻 HIR 与不常驻 HIR，
+ * 底部总是 LIR，更靠下的 HIR 在修剪时移出栈；队列 Q 按进入先后排列常驻 HIR，淘汰总是取 Q 的头部。
+ * HIR 在栈中再次被访问，说明它的重用距离比栈底的 LIR 短，升为 LIR，栈底的 LIR 降为 HIR 进入 Q。
+ * 被淘汰的 HIR 若还在栈中，保留 key（不保留值）成为不常驻 HIR，再次写入时直接成为 LIR；
+ * 不常驻 HIR 最多 historyCapacity 个，超出时丢弃最早被淘汰的，因此循环长度略超过容量时也只有少量条目反复失效。
+ * get 未命中不算访问，紧接着的 put 才按未命中处理
+ * @tparam Key
+ * @tparam Value
+ */
+template<typename Key, typename Value>
+class LIRS : public CachePolicy<Key, Value> {
+  using Index = uint32_t;
+  using NodeMap = FlatMap<Key, Index>;
+  static constexpr Index kNil = UINT32_MAX;
+ public:
+  explicit LIRS(size_t capacity)
+	  : LIRS(capacity, capacity) {}
+
+  LIRS(size_t capacity, size_t historyCapacity, double hirRatio = 0.01)
+	  : capacity_(capacity), historyCapacity_(historyCapacity), size_(0), lirCount_(0), historySize_(0),
+		free_(kNil), values_(std::make_unique<Value[]>(capacity)) {
+	  assert(capacity_ + historyCapacity_ + kLists < kNil);
+	  assert(hirRatio > 0 && hirRatio < 1);
+	  hirCapacity_ = std::max<size_t>(static_cast<size_t>(capacity_ * hirRatio), 1);
+	  lirCapacity_ = capacity_ > hirCapacity_ ? capacity_ - hirCapacity_ : 0;
+	  // 末尾为栈、Q、不常驻 HIR 链表的虚拟节点，其余节点串成空闲链表
+	  auto total = capacity_ + historyCapacity_;
+	  nodes_.resize(total + kLists);
+	  for (size_t i = total; i-- > 0;) {
+		  nodes_[i].next_ = free_;
+		  free_ = static_cast<Index>(i);
+	  }
+	  auto stack = sentinel(kStack);
+	  nodes_[stack].up_ = stack;
+	  nodes_[stack].down_ = stack;
+	  for (auto list : {kQueue, kHistory}) {
+		  auto head = sentinel(list);
+		  nodes_[head].prev_ = head;
+		  nodes_[head].next_ = head;
+	  }
+	  freeSlots_.reserve(capacity_);
+	  for (size_t slot = capacity_; slot-- > 0;) {
+		  freeSlots_.push_back(static_cast<Index>(slot));
+	  }
+	  nodeMap_.reserve(total);
+  }
+
+  ~LIRS() = default;
+
+  void put(Key key, Value value) override {
+	  if (capacity_ <= 0) {
+		  return;
+	  }
+
+	  // 常驻则更新节点值，按一次命中处理
+	  auto it = nodeMap_.find(key);
+	  Index index = kNil;
+	  if (it != nodeMap_.end()) {
+		  index = it->second;
+		  if (nodes_[index].status_ != kNonResident) {
+			  values_[nodes_[index].slot_] = std::move(value);
+			  access(index);
+			  return;
+		  }
+		  // 不常驻 HIR 即将重新常驻，先移出不常驻链表，避免腾空间时被当作最早的历史丢弃
+		  unlink(index);
+		  --historySize_;
+	  }
+
+	  if (size_ == capacity_) {
+		  evict();
+	  }
+	  if (index == kNil) {
+		  index = free_;
+		  free_ = nodes_[index].next_;
+		  nodes_[index].key_ = key;
+		  nodeMap_.emplace(std::move(key), index);
+	  }
+	  auto &node = nodes_[index];
+	  node.slot_ = freeSlots_.back();
+	  freeSlots_.pop_back();
+	  values_[node.slot_] = std::move(value);
+	  ++size_;
+
+	  if (node.inStack_) {
+		  // 不常驻 HIR 的重用距离比栈底的 LIR 短，升为 LIR
+		  removeFromStack(index);
+		  pushStack(index);
+		  promote(index);
+	  } else if (lirCount_ < lirCapacity_) {
+		  // LIR 未满时新条目直接成为 LIR
+		  node.status_ = kLir;
+		  ++lirCount_;
+		  pushStack(index);
+	  } else {
+		  node.status_ = kHirResident;
+		  pushStack(index);
+		  link(index, kQueue);
+	  }
+  }
+
+  std::optional<Value> get(const Key &key) override {
+	  auto it = nodeMap_.find(key);
+	  if (it == nodeMap_.end() || nodes_[it->second].status_ == kNonResident) {
+		  return std::nullopt;
+	  }
+	  access(it->second);
+	  return values_[nodes_[it->second].slot_];
+  }
+
+  size_t size() const { return size_; }
+
+  size_t capacity() const { return capacity_; }
+
+  // 不常驻 HIR（只保留 key）的数量
+  size_t historySize() const { return historySize_; }
+
+ private:
+  enum Status : uint8_t {
+	kLir = 0,
+	kHirResident = 1,
+	kNonResident = 2
+  };
+
+  // 栈用 up_/down_ 链接；Q 与不常驻 HIR 链表互斥，共用 prev_/next_
+  enum List : uint8_t {
+	kStack = 0,
+	kQueue = 1,
+	kHistory = 2,
+	kLists = 3
+  };
+
+  struct Node {
+	  Key key_;
+	  Index slot_ = kNil;            // 常驻时值在 values_ 中的下标
+	  Index up_ = kNil;                // 栈中靠近栈顶的相邻节点
+	  Index down_ = kNil;            // 栈中靠近栈底的相邻节点
+	  Index prev_ = kNil;            // Q 或不常驻链表中更早的相邻节点
+	  Index next_ = kNil;            // Q 或不常驻链表中更晚的相邻节点，空闲时为空闲链表的下一个
+	  Status status_ = kLir;
+	  bool inStack_ = false;
+  };
+
+  Index sentinel(List list) const { return static_cast<Index>(capacity_ + historyCapacity_ + list); }
+
+  Index bottom() const { return nodes_[sentinel(kStack)].up_; }
+
+  Index front(List list) const { return nodes_[sentinel(list)].next_; }
+
+  // 常驻条目被访问
+  void access(Index index) {
+	  auto &node = nodes_[index];
+	  if (node.status_ == kLir) {
+		  bool wasBottom = bottom() == index;
+		  removeFromStack(index);
+		  pushStack(index);
+		  if (wasBottom) {
+			  prune();
+		  }
+		  return;
+	  }
+	  // 常驻 HIR
+	  unlink(index);
+	  if (node.inStack_) {
+		  removeFromStack(index);
+		  pushStack(index);
+		  promote(index);
+	  } else {
+		  pushStack(index);
+		  link(index, kQueue);
+	  }
+  }
+
+  // 栈顶的 HIR 升为 LIR，LIR 超出容量时栈底的 LIR 降为 HIR 进入 Q。
+  // 容量为 1 时 LIR 容量为 0，栈中原本没有 LIR，栈底可能是 HIR，先修剪保证栈底是 LIR（可能就是 index 自己）
+  void promote(Index index) {
+	  nodes_[index].status_ = kLir;
+	  ++lirCount_;
+	  if (lirCount_ <= lirCapacity_) {
+		  return;
+	  }
+	  prune();
+	  auto demoted = bottom();
+	  assert(nodes_[demoted].status_ == kLir);
+	  removeFromStack(demoted);
+	  nodes_[demoted].status_ = kHirResident;
+	  --lirCount_;
+	  link(demoted, kQueue);
+	  prune();
+  }
+
+  // 移除栈底的 HIR，直到栈底为 LIR；不常驻 HIR 移出栈后不再有用，一并释放
+  void prune() {
+	  while (true) {
+		  auto index = bottom();
+		  if (index == sentinel(kStack) || nodes_[index].status_ == kLir) {
+			  return;
+		  }
+		  removeFromStack(index);
+		  if (nodes_[index].status_ == kNonResident) {
+			  unlink(index);
+			  --historySize_;
+			  release(index);
+		  }
+	  }
+  }
+
+  // 淘汰 Q 头部的常驻 HIR，还在栈中的保留 key 成为不常驻 HIR
+  void evict() {
+	  auto index = front(kQueue);
+	  unlink(index);
+	  auto &node = nodes_[index];
+	  values_[node.slot_] = Value{};
+	  freeSlots_.push_back(node.slot_);
+	  node.slot_ = kNil;
+	  --size_;
+	  if (!node.inStack_) {
+		  release(index);
+		  return;
+	  }
+	  node.status_ = kNonResident;
+	  link(index, kHistory);
+	  // 超出上限时丢弃最早被淘汰的，它不会在栈底，移出后不需要修剪
+	  if (++historySize_ > historyCapacity_) {
+		  auto oldest = front(kHistory);
+		  unlink(oldest);
+		  removeFromStack(oldest);
+		  --historySize_;
+		  release(oldest);
+	  }
+  }
+
+  void release(Index index) {
+	  nodeMap_.erase(nodes_[index].key_);
+	  nodes_[index].next_ = free_;
+	  free_ = index;
+  }
+
+  void pushStack(Index index) {
+	  auto top = sentinel(kStack);
+	  auto &node = nodes_[index];
+	  node.up_ = top;
+	  node.down_ = nodes_[top].down_;
+	  nodes_[nodes_[top].down_].up_ = index;
+	  nodes_[top].down_ = index;
+	  node.inStack_ = true;
+  }
+
+  void removeFromStack(Index index) {
+	  auto &node = nodes_[index];
+	  nodes_[node.up_].down_ = node.down_;
+	  nodes_[node.down_].up_ = node.up_;
+	  node.inStack_ = false;
+  }
+
+  // 插入到链表尾部
+  void link(Index index, List list) {
+	  auto head = sentinel(list);
+	  auto &node = nodes_[index];
+	  node.next_ = head;
+	  node.prev_ = nodes_[head].prev_;
+	  nodes_[nodes_[head].prev_].next_ = index;
+	  nodes_[head].prev_ = index;
+  }
+
+  void unlink(Index index) {
+	  auto &node = nodes_[index];
+	  nodes_[node.prev_].next_ = node.next_;
+	  nodes_[node.next_].prev_ = node.prev_;
+  }
+
+ private:
+  size_t capacity_;                        // 缓存容量
+  size_t historyCapacity_;                // 不常驻 HIR 的上限
+  size_t lirCapacity_;                    // LIR 容量
+  size_t hirCapacity_;                    // 常驻 HIR 容量
+  size_t size_;                            // 常驻条目数
+  size_t lirCount_;                        // LIR 条目数
+  size_t historySize_;                    // 不常驻 HIR 条目数
+  Index free_;                            // 空闲节点链表
+  std::vector<Node> nodes_;                // 节点，末尾为三个虚拟节点
+  std::unique_ptr<Value[]> values_;        // 常驻条目的值
+  std::vector<Index> freeSlots_;        // 空闲的值下标
+  NodeMap nodeMap_;                        // key 到节点下标，包括不常驻 HIR
+
+ public:
+// 删除拷贝语义
+  LIRS(const LIRS &other) = delete;
+  LIRS &operator=(const LIRS &other) = delete;
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_LIRS_H_
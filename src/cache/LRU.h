@@ -12,26 +12,37 @@
 #define CACHE_SRC_CACHE_LRU_H_
 
 #include <iostream>
+#include <chrono>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
+#include <vector>
+#include <algorithm>
 
 #include "CachePolicy.h"
+#include "FlatMap.h"
+#include "ChangeSet.h"
+#include "CacheWeigher.h"
+#include "TimingWheel.h"
 
 namespace Cache {
 
-template<typename Key, typename Value>
+template<typename Key, typename Value, typename Weigher = UnitWeigher<Key, Value>>
 class LRU;
 template<typename Key, typename Value>
 class LRUCache;
+template<typename Key, typename Value>
+class MultiLRU;
 
+// 继承 TimerHook，设置过期时间的节点直接挂到时间轮上
 template<typename Key, typename Value>
-class LruNode {
-  friend class LRU<Key, Value>;
+class LruNode : public TimerHook {
+  template<typename K, typename V, typename W> friend
+  class LRU;
   friend class LRUCache<Key, Value>;
+  friend class MultiLRU<Key, Value>;
  public:
   LruNode(Key key, Value value)
-	  : key_(key), value_(value),count_(1),prev_(nullptr), next_(nullptr) {}
+	  : key_(std::move(key)), value_(std::move(value)),count_(1), weight_(1), version_(0), prev_(nullptr), next_(nullptr) {}
 
   ~LruNode() {
 	  prev_ = nullptr;
@@ -42,22 +53,28 @@ class LruNode {
   Key key_;
   Value value_;
   size_t count_;
+  size_t weight_;    // 条目权重，淘汰时从总权重中扣除
+  uint64_t version_;    // 最后一次写入的版本号，只用于多线程缓存之间同步时判断新旧
   std::shared_ptr<LruNode<Key, Value>> prev_;
   std::shared_ptr<LruNode<Key, Value>> next_;
 };
 
-template<typename Key, typename Value>
-class KLru;
-
-template<typename Key, typename Value>
+/**
+ * @brief capacity 为权重之和的上限，默认每个条目权重为 1，即条目数上限；
+ * 传入按字节计算的 Weigher 时 capacity 即为字节预算，插入时从尾部连续淘汰直到新条目放得下
+ * @tparam Key
+ * @tparam Value
+ * @tparam Weigher 形如 size_t(const Key &, const Value &)
+ */
+template<typename Key, typename Value, typename Weigher>
 class LRU : public CachePolicy<Key, Value> {
-  friend class KLru<Key, Value>;
  public:
   using NodeType = LruNode<Key, Value>;
   using NodePtr = std::shared_ptr<NodeType>;
-  using NodeMap = std::unordered_map<Key, NodePtr>;
+  using NodeMap = FlatMap<Key, NodePtr>;
 
-  explicit LRU(size_t capacity) : capacity_(capacity) { init(); }
+  explicit LRU(size_t capacity, Weigher weigher = Weigher())
+	  : capacity_(capacity), totalWeight_(0), weigher_(std::move(weigher)) { init(); }
 
   ~LRU() {
 	  clearMap();
@@ -67,29 +84,80 @@ class LRU : public CachePolicy<Key, Value> {
 
   NodeMap &nodeMap() { return nodeMap_; }
 
+  // 不带过期时间的写入，已有的过期时间会被清除
   void put(Key key, Value value) override {
-	  if (capacity_ <= 0) {
-		  return;
+	  tick();
+	  if (auto node = insert(std::move(key), std::move(value))) {
+		  wheel_.cancel(node);
 	  }
+  }
 
-	  // 如果存在，更新节点值, 并移到头部
+  // 写入后经过 ttl 过期，过期的条目不会再被读到，由之后的写入及按采样节奏的未命中读取回收
+  void put(Key key, Value value, std::chrono::nanoseconds ttl) {
+	  tick();
+	  if (auto node = insert(std::move(key), std::move(value))) {
+		  wheel_.schedule(node, ttl);
+	  }
+  }
+
+  std::optional<Value> get(const Key &key) override {
+	  return lookup(key);
+  }
+
+  // 异构查找，例如 Key 为 std::string 时可以直接用 std::string_view 查找
+  template<typename K>
+  std::optional<Value> get(const K &key) {
+	  return lookup(key);
+  }
+
+  // 只读取值，不改变淘汰顺序，也不计入访问次数
+  std::optional<Value> peek(const Key &key) const {
 	  auto it = nodeMap_.find(key);
-	  if (it != nodeMap_.end()) {
-		  it->second->value_ = value;
-		  moveToHead(it->second);
-		  return;
+	  // 只读访问不推进时间轮，设置了过期时间的条目直接按时钟判断
+	  if (it == nodeMap_.end() || (it->second->scheduled() && it->second->expired(wheel_.current()))) {
+		  return std::nullopt;
 	  }
-	  // 如果超过缓存容量，淘汰末尾节点
-	  if (nodeMap_.size() >= capacity_) {
-		  cacheLastNode();
+	  return it->second->value_;
+  }
+
+  // 距过期还剩多久，条目不存在或没有设置过期时间时为空
+  std::optional<std::chrono::nanoseconds> ttl(const Key &key) const {
+	  auto it = nodeMap_.find(key);
+	  if (it == nodeMap_.end() || !it->second->scheduled()) {
+		  return std::nullopt;
 	  }
-	  // 头部插入节点
-	  addHeadNode(key, value);
+	  return wheel_.remaining(it->second.get());
+  }
+
+  size_t size() const { return nodeMap_.size(); }
+
+  // 设置了过期时间且尚未回收的条目数
+  size_t expiringSize() const { return wheel_.size(); }
+
+  // 当前所有条目的权重之和，不超过 capacity
+  size_t totalWeight() const { return totalWeight_; }
+
+  size_t capacity() const { return capacity_; }
+
+  // 每个条目除 key、value 之外的内存开销估算：节点中的指针、计数与权重，make_shared 控制块，
+  // 索引槽位（key 副本与节点指针）及其控制字节，未计入哈希表的空闲槽位
+  static constexpr size_t nodeOverhead() {
+	  return sizeof(NodeType) - sizeof(Key) - sizeof(Value) + kSharedBlockOverhead
+		  + sizeof(typename NodeMap::value_type) + 1;
   }
 
-  std::optional<Value> get(Key key) override {
+ private:
+  template<typename K>
+  std::optional<Value> lookup(const K &key) {
 	  auto it = nodeMap_.find(key);
 	  if (it == nodeMap_.end()) {
+		  tick(true);
+		  return std::nullopt;
+	  }
+	  // 命中不推进时间轮：没有过期时间的条目只判断一次，设置了过期时间的条目才按时钟判断，
+	  // 已过期但还没轮到回收的按未命中处理，顺便回收
+	  if (it->second->scheduled() && it->second->expired(wheel_.current())) {
+		  eraseNode(it->second);
 		  return std::nullopt;
 	  }
 	  it->second->count_++;
@@ -99,7 +167,56 @@ class LRU : public CachePolicy<Key, Value> {
 	  return it->second->value_;
   }
 
- private:
+  // 写入或更新节点，返回写入后的节点，放不下时返回 nullptr
+  NodeType *insert(Key key, Value value) {
+	  if (capacity_ <= 0) {
+		  return nullptr;
+	  }
+
+	  auto weight = weigher_(key, value);
+	  auto it = nodeMap_.find(key);
+	  // 单个条目超过整个容量，放不下，旧值也不再有效
+	  if (weight > capacity_) {
+		  if (it != nodeMap_.end()) {
+			  eraseNode(it->second);
+		  }
+		  return nullptr;
+	  }
+
+	  // 如果存在，更新节点值, 并移到头部
+	  if (it != nodeMap_.end()) {
+		  auto node = it->second;
+		  totalWeight_ = totalWeight_ - node->weight_ + weight;
+		  node->weight_ = weight;
+		  node->value_ = std::move(value);
+		  moveToHead(node);
+		  // 新值变大时可能超出容量，节点已在头部，不会淘汰到自己
+		  while (totalWeight_ > capacity_) {
+			  cacheLastNode();
+		  }
+		  return node.get();
+	  }
+	  // 超过缓存容量时从末尾连续淘汰，直到新节点放得下
+	  while (totalWeight_ + weight > capacity_) {
+		  cacheLastNode();
+	  }
+	  // 头部插入节点
+	  return addHeadNode(std::move(key), std::move(value), weight);
+  }
+
+  // 协作式推进时间轮，没有设置过期时间的条目时只有一次判断；sampled 为 true 时按采样节奏推进，用于读路径
+  void tick(bool sampled = false) {
+	  if (wheel_.empty() || (sampled && !wheel_.sample())) {
+		  return;
+	  }
+	  wheel_.advance([this](NodeType *node) {
+		auto it = nodeMap_.find(node->key_);
+		if (it != nodeMap_.end()) {
+			eraseNode(it->second);
+		}
+	  });
+  }
+
   void init() {
 	  dummyHead_ = std::make_shared<NodeType>(Key(), Value());
 	  dummyTail_ = std::make_shared<NodeType>(Key(), Value());
@@ -151,90 +268,359 @@ class LRU : public CachePolicy<Key, Value> {
   void cacheLastNode() {
 	  auto node = dummyTail_->prev_;
 	  if (node == dummyHead_) return;    // 说明缓存为空，不应该删除
+	  eraseNode(node);
+  }
+
+  void eraseNode(NodePtr node) {
+	  wheel_.cancel(node.get());
+	  totalWeight_ -= node->weight_;
 	  nodeMap_.erase(node->key_);
 	  removeNode(node);
   }
 
-  void addHeadNode(Key key, Value value) {
-	  auto newNode = std::make_shared<NodeType>(key, value);
+  NodeType *addHeadNode(Key key, Value value, size_t weight) {
+	  auto newNode = std::make_shared<NodeType>(key, std::move(value));
+	  auto raw = newNode.get();
+	  newNode->weight_ = weight;
+	  totalWeight_ += weight;
 	  insertNode(newNode);
-	  nodeMap_[key] = newNode;
+	  nodeMap_.emplace(std::move(key), std::move(newNode));
+	  return raw;
   }
 
  private:
-  size_t capacity_;            // 缓存容量，超过容量触发淘汰机制
+  size_t capacity_;            // 缓存容量（权重之和的上限），超过容量触发淘汰机制
+  size_t totalWeight_;        // 当前权重之和
+  Weigher weigher_;            // 计算条目权重
+  TimingWheel<NodeType> wheel_;    // 设置了过期时间的节点
   NodePtr dummyHead_;        // 虚拟头结点
   NodePtr dummyTail_;        // 虚拟尾结点
   NodeMap nodeMap_;            // 目的：查询 key 的时间复杂度为 O(1)
 };
 
 /**
- * @brief K-LRU，让高频访问的缓存不容易失效，某个缓存，必须达到 k 次访问次数，才能加入到缓存中
+ * @brief LRU-K：淘汰倒数第 K 次访问距今最久（backward K-distance 最大）的条目。
+ * 访问次数不足 K 次的条目 K-distance 视为无穷大，最先被淘汰，它们之间按最近一次访问的先后淘汰，
+ * 因此只访问一次的扫描 key 不会挤掉访问过 K 次以上的热点。
+ * 常驻条目按（倒数第 K 次访问时间，最近一次访问时间）放在下标化的最小堆中，访问与淘汰都是 O(log n)。
+ * 被淘汰或未命中的 key 只保留访问时间（不保留值），最多 historyCapacity 个，超出时丢弃最久未访问的，
+ * 再次写入时恢复这些访问时间。时间为逻辑时钟，每次 get、put 加一；
+ * get 未命中后紧接着 put 同一个 key 视为同一次访问
  * @tparam Key
  * @tparam Value
  */
-
 template<typename Key, typename Value>
-class KLru : public LRU<Key, Value> {
-  using waitMap = std::unordered_map<Key, std::pair<Value, size_t>>;
+class KLru : public CachePolicy<Key, Value> {
+  using Index = uint32_t;
+  using IndexMap = FlatMap<Key, Index>;
+  static constexpr Index kNil = UINT32_MAX;
  public:
   explicit KLru(size_t capacity, size_t k)
-	  : LRU<Key, Value>(capacity), k_(k) {}
+	  : KLru(capacity, k, capacity) {}
+
+  KLru(size_t capacity, size_t k, size_t historyCapacity)
+	  : capacity_(capacity), k_(std::max<size_t>(k, 1)), historyCapacity_(historyCapacity)
+		, now_(0), size_(0), historySize_(0), historyFree_(kNil) {
+	  entries_.resize(capacity_);
+	  times_.assign(capacity_ * k_, 0);
+	  pending_.assign(k_, 0);
+	  heap_.reserve(capacity_);
+	  nodeMap_.reserve(capacity_);
+	  // 历史记录的最后一个节点作为虚拟头尾节点
+	  history_.resize(historyCapacity_ + 1);
+	  historyTimes_.assign(historyCapacity_ * k_, 0);
+	  history_[historySentinel()].prev_ = historySentinel();
+	  history_[historySentinel()].next_ = historySentinel();
+	  historyMap_.reserve(historyCapacity_);
+  }
 
   ~KLru() = default;
 
-  std::optional<Value> get(Key key) {
-	  auto it = waitList.find(key);
-	  if (it != waitList.end()) {
-		  it->second.second++;
-		  if (it->second.second >= k_) {
-			  LRU<Key, Value>::put(key, it->second.first);
-			  waitList.erase(it);
-		  }
+  std::optional<Value> get(const Key &key) override {
+	  ++now_;
+	  auto it = nodeMap_.find(key);
+	  if (it != nodeMap_.end()) {
+		  auto index = it->second;
+		  record(&times_[index * k_]);
+		  siftDown(entries_[index].heapPos_);
+		  return entries_[index].value_;
 	  }
-	  return LRU<Key, Value>::get(key);
+	  // 未命中只记录访问时间
+	  auto hit = historyMap_.find(key);
+	  if (hit != historyMap_.end()) {
+		  record(&historyTimes_[hit->second * k_]);
+		  moveHistoryToHead(hit->second);
+	  } else {
+		  addHistory(key, nullptr);
+	  }
+	  return std::nullopt;
   }
 
-  void put(Key key, Value value) {
-	  if (LRU<Key,Value>::get(key) != std::nullopt) {
-		  LRU<Key, Value>::put(key, value);
+  void put(Key key, Value value) override {
+	  if (capacity_ <= 0) {
+		  return;
+	  }
+
+	  auto it = nodeMap_.find(key);
+	  if (it != nodeMap_.end()) {
+		  ++now_;
+		  auto index = it->second;
+		  entries_[index].value_ = std::move(value);
+		  record(&times_[index * k_]);
+		  siftDown(entries_[index].heapPos_);
 		  return;
 	  }
 
-	  auto it = waitList.find(key);
-	  if (it != waitList.end()) {
-		  it->second.first = value;
-		  it->second.second++;
-		  if (it->second.second >= k_) {
-			  LRU<Key, Value>::put(key, value);
-			  waitList.erase(it);
+	  // 先取出历史访问时间再淘汰：淘汰的条目进入历史记录，历史记录满时可能挤掉的正是这个 key
+	  std::fill(pending_.begin(), pending_.end(), 0);
+	  auto hit = historyMap_.find(key);
+	  bool restored = hit != historyMap_.end();
+	  if (restored) {
+		  auto history = hit->second;
+		  std::copy_n(&historyTimes_[history * k_], k_, pending_.begin());
+		  removeHistory(history);
+	  }
+	  // 满时淘汰堆顶，新条目不参与这次淘汰
+	  Index index = size_ < capacity_ ? static_cast<Index>(size_++) : evict();
+	  auto times = &times_[index * k_];
+	  std::copy_n(pending_.begin(), k_, times);
+	  // 刚刚未命中过的 key 恢复后不再重复计一次访问
+	  if (!restored || times[0] != now_) {
+		  ++now_;
+		  record(times);
+	  }
+	  auto &entry = entries_[index];
+	  entry.key_ = key;
+	  entry.value_ = std::move(value);
+	  nodeMap_.emplace(std::move(key), index);
+	  entry.heapPos_ = heap_.size();
+	  heap_.push_back(index);
+	  siftUp(entry.heapPos_);
+  }
+
+  size_t size() const { return size_; }
+
+  size_t capacity() const { return capacity_; }
+
+  // 保留了访问时间的非常驻 key 数
+  size_t historySize() const { return historySize_; }
+
+ private:
+  struct Entry {
+	  Key key_;
+	  Value value_;
+	  size_t heapPos_ = 0;
+  };
+
+  struct HistoryNode {
+	  Key key_;
+	  Index prev_ = kNil;
+	  Index next_ = kNil;
+  };
+
+  // 访问时间按从新到旧排列，times[0] 为最近一次，times[k_ - 1] 为倒数第 K 次，0 表示没有
+  void record(uint64_t *times) {
+	  std::copy_backward(times, times + k_ - 1, times + k_);
+	  times[0] = now_;
+  }
+
+  // 堆中 a 是否应排在 b 之前：倒数第 K 次访问更早的先淘汰，相同时最近一次访问更早的先淘汰
+  bool before(Index a, Index b) const {
+	  auto ta = &times_[a * k_], tb = &times_[b * k_];
+	  if (ta[k_ - 1] != tb[k_ - 1]) {
+		  return ta[k_ - 1] < tb[k_ - 1];
+	  }
+	  return ta[0] < tb[0];
+  }
+
+  void place(size_t pos, Index index) {
+	  heap_[pos] = index;
+	  entries_[index].heapPos_ = pos;
+  }
+
+  void siftUp(size_t pos) {
+	  auto index = heap_[pos];
+	  while (pos > 0) {
+		  auto parent = (pos - 1) / 2;
+		  if (!before(index, heap_[parent])) {
+			  break;
+		  }
+		  place(pos, heap_[parent]);
+		  pos = parent;
+	  }
+	  place(pos, index);
+  }
+
+  // 访问只会让条目的优先级变大，向下调整即可
+  void siftDown(size_t pos) {
+	  auto index = heap_[pos];
+	  auto size = heap_.size();
+	  while (true) {
+		  auto child = 2 * pos + 1;
+		  if (child >= size) {
+			  break;
 		  }
+		  if (child + 1 < size && before(heap_[child + 1], heap_[child])) {
+			  ++child;
+		  }
+		  if (!before(heap_[child], index)) {
+			  break;
+		  }
+		  place(pos, heap_[child]);
+		  pos = child;
+	  }
+	  place(pos, index);
+  }
+
+  // 淘汰堆顶条目，访问时间转入历史记录，返回空出的下标
+  Index evict() {
+	  auto victim = heap_[0];
+	  auto last = heap_.back();
+	  heap_.pop_back();
+	  if (!heap_.empty()) {
+		  place(0, last);
+		  siftDown(0);
+	  }
+	  auto &entry = entries_[victim];
+	  addHistory(entry.key_, &times_[victim * k_]);
+	  nodeMap_.erase(entry.key_);
+	  return victim;
+  }
+
+  Index historySentinel() const { return static_cast<Index>(historyCapacity_); }
+
+  // times 为空表示本次未命中是第一次访问
+  void addHistory(const Key &key, const uint64_t *times) {
+	  if (historyCapacity_ == 0) {
+		  return;
+	  }
+	  // 历史记录已满，丢弃最久未访问的
+	  if (historySize_ == historyCapacity_) {
+		  removeHistory(history_[historySentinel()].prev_);
+	  }
+	  // 优先复用空闲节点，没有空闲节点时已用的节点都在链表中，下一个节点即为 historySize_
+	  Index index;
+	  if (historyFree_ != kNil) {
+		  index = historyFree_;
+		  historyFree_ = history_[index].next_;
+	  } else {
+		  index = static_cast<Index>(historySize_);
+	  }
+	  auto historyTimes = &historyTimes_[index * k_];
+	  if (times) {
+		  std::copy_n(times, k_, historyTimes);
 	  } else {
-		  waitList[key] = std::make_pair(value, 1);
+		  std::fill(historyTimes, historyTimes + k_, 0);
+		  historyTimes[0] = now_;
 	  }
+	  history_[index].key_ = key;
+	  historyMap_.emplace(key, index);
+	  linkHistory(index);
+	  ++historySize_;
+  }
+
+  // 移出历史记录，节点放回空闲链表
+  void removeHistory(Index index) {
+	  unlinkHistory(index);
+	  historyMap_.erase(history_[index].key_);
+	  history_[index].next_ = historyFree_;
+	  historyFree_ = index;
+	  --historySize_;
+  }
+
+  void moveHistoryToHead(Index index) {
+	  unlinkHistory(index);
+	  linkHistory(index);
+  }
+
+  void unlinkHistory(Index index) {
+	  auto &node = history_[index];
+	  history_[node.prev_].next_ = node.next_;
+	  history_[node.next_].prev_ = node.prev_;
+  }
+
+  void linkHistory(Index index) {
+	  auto &head = history_[historySentinel()];
+	  auto &node = history_[index];
+	  node.next_ = head.next_;
+	  node.prev_ = historySentinel();
+	  history_[head.next_].prev_ = index;
+	  head.next_ = index;
   }
 
  private:
-  size_t k_;
-  waitMap waitList;
+  size_t capacity_;                    // 缓存容量
+  size_t k_;                        // 按倒数第 k_ 次访问淘汰
+  size_t historyCapacity_;            // 最多保留多少个非常驻 key 的访问时间
+  uint64_t now_;                    // 逻辑时钟
+  size_t size_;                        // 已使用的条目数
+  size_t historySize_;                // 历史记录中的 key 数
+  Index historyFree_;                // 历史记录空闲链表
+  std::vector<Entry> entries_;        // 常驻条目
+  std::vector<uint64_t> times_;        // 常驻条目的访问时间，每个条目 k_ 个
+  std::vector<uint64_t> pending_;    // 写入新 key 时暂存它的历史访问时间，k_ 个
+  std::vector<Index> heap_;            // 常驻条目的最小堆
+  IndexMap nodeMap_;                // key 到常驻条目下标
+  std::vector<HistoryNode> history_;        // 历史记录，按最近访问排列，最后一个为虚拟节点
+  std::vector<uint64_t> historyTimes_;    // 历史记录的访问时间，每个 key k_ 个
+  IndexMap historyMap_;                    // key 到历史记录下标
+
+ public:
+// 删除拷贝语义
+  KLru(const KLru &other) = delete;
+  KLru &operator=(const KLru &other) = delete;
 };
 
 template<typename Key, typename Value>
 class MultiLRU {
   using LRUptr = std::shared_ptr<LRU<Key, Value>>;
-  using PNodeMap = std::unordered_map<Key, std::shared_ptr<LruNode<Key, Value>>>;
  public:
-  explicit MultiLRU(size_t capacity = 1)
-	  : cache_(std::make_shared<LRU<Key, Value>>(capacity)), pending_(std::make_shared<LRU<Key, Value>>(capacity)) {}
+  using Entry = ChangeEntry<Key, Value>;
+
+  // trackChanges 为 false 时不记录脏 key，用于不需要同步的哈希路由
+  explicit MultiLRU(size_t capacity = 1, bool trackChanges = true)
+	  : cache_(std::make_shared<LRU<Key, Value>>(capacity)) {
+	  if (trackChanges) {
+		  changes_ = std::make_unique<ChangeSet<Key, Value>>(capacity);
+	  }
+  }
 
   ~MultiLRU() = default;
 
-  void put(Key key, Value value) {
-	  cache_->put(key, value);
-	  pending_->put(key, value);
+  /**
+   * @brief 写入并记为本分片的脏 key。版本号在调用方线程分配后才投递，投递可能晚于同步：
+   * 本分片已有同步来的更新版本时跳过，否则本分片留下旧值，其它分片又因版本更新而跳过它，各分片永久不一致
+   * @param version 写入的版本号，由管理者在调用方线程统一分配，所有分片共用一个计数；不记录脏 key 时忽略
+   */
+  void put(Key key, Value value, uint64_t version) {
+	  if (!changes_) {
+		  cache_->put(std::move(key), std::move(value));
+		  return;
+	  }
+	  if (stale(key, version)) {
+		  return;
+	  }
+	  // 先写入缓存再记录：记录时可能清理已被淘汰的 key，此时本次写入的 key 必须已在缓存中
+	  cache_->put(key, std::move(value));
+	  stamp(key, version);
+	  changes_->mark(key, version, [this](const Key &k) { return cache_->peek(k); });
+  }
+
+  // 带过期时间的写入，同步到其它分片时一并带上剩余的过期时间
+  void put(Key key, Value value, std::chrono::nanoseconds ttl, uint64_t version) {
+	  if (!changes_) {
+		  cache_->put(std::move(key), std::move(value), ttl);
+		  return;
+	  }
+	  if (stale(key, version)) {
+		  return;
+	  }
+	  cache_->put(key, std::move(value), ttl);
+	  stamp(key, version);
+	  changes_->mark(key, version, [this](const Key &k) { return cache_->peek(k); });
   }
 
-  std::optional<Value> get(Key key) {
+  std::optional<Value> get(const Key &key) {
 	  return cache_->get(key);
   }
 
@@ -242,26 +628,59 @@ class MultiLRU {
 	  return cache_->get(key, value);
   }
 
-  PNodeMap &pending(bool isSwap = true) {
-	  if (isSwap) {
-		  swap();
+  // 取走本分片自上次同步以来写过且仍在缓存中的 key 及其当前值，未开启记录时为空
+  std::vector<Entry> drainChanges() {
+	  if (!changes_) {
+		  return {};
+	  }
+	  auto entries = changes_->drain([this](const Key &key) { return cache_->peek(key); });
+	  // 其它分片按剩余时间设置过期，副本与本分片的条目同时过期
+	  for (auto &entry : entries) {
+		  entry.ttl_ = cache_->ttl(entry.key_);
+	  }
+	  return entries;
+  }
+
+  /**
+   * @brief 应用其它分片的变更：只写缓存，不记为本分片的脏 key。
+   * 本分片已有版本号不小于它的写入时跳过，同一个 key 在多个分片上写过时各分片都保留版本号最大的值，
+   * 同一批变更重复投递也不会重复写入
+   * @param entries 一批变更，顺序不限
+   */
+  void apply(const std::vector<Entry> &entries) {
+	  for (const auto &entry : entries) {
+		  if (stale(entry.key_, entry.version_)) {
+			  continue;
+		  }
+		  if (entry.ttl_) {
+			  cache_->put(entry.key_, entry.value_, *entry.ttl_);
+		  } else {
+			  cache_->put(entry.key_, entry.value_);
+		  }
+		  stamp(entry.key_, entry.version_);
 	  }
-	  return pending_->nodeMap();
   }
 
-  void swap() {        // 得加锁
-	  std::lock_guard<std::mutex> _lock(mutex_);
-	  std::swap(cache_, pending_);
+ private:
+  // 本分片已有版本号不小于 version 的写入
+  bool stale(const Key &key, uint64_t version) {
+	  auto it = cache_->nodeMap().find(key);
+	  return it != cache_->nodeMap().end() && it->second->version_ >= version;
+  }
+
+  // 记录条目当前值的版本号，条目放不下被丢弃时什么也不做
+  void stamp(const Key &key, uint64_t version) {
+	  auto it = cache_->nodeMap().find(key);
+	  if (it != cache_->nodeMap().end()) {
+		  it->second->version_ = version;
+	  }
   }
 
  private:
   LRUptr cache_;           // 对外提供服务的缓存
-  LRUptr pending_;        // 增量缓存
-  std::mutex mutex_;
+  std::unique_ptr<ChangeSet<Key, Value>> changes_;    // 本分片的脏 key
 };
 
 }
 
 #endif //CACHE_SRC_CACHE_LRU_H_
-
-
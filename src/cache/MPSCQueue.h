@@ -0,0 +1,103 @@
+/**
+  ******************************************************************************
+  * @file           : MPSCQueue.h
+  * @author         : xy
+  * @brief          : 有界无锁多生产者单消费者环形队列
+  * @attention      : 槽位在构造时一次性分配；tryPop 只能由唯一的消费者线程调用
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_MPSCQUEUE_H_
+#define CACHE_SRC_CACHE_MPSCQUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace Cache {
+
+/**
+ * @brief 每个槽位带一个序号：序号等于写位置表示可写，等于写位置 + 1 表示可读。
+ * 生产者通过 CAS 抢占写位置，写完数据后发布序号；消费者只有一个，读位置不需要原子操作
+ * @tparam T
+ */
+template<typename T>
+class MPSCQueue {
+ public:
+  explicit MPSCQueue(size_t capacity = 4096) {
+	  // 容量向上取整为 2 的幂，用掩码代替取模
+	  size_t size = 2;
+	  while (size < capacity) {
+		  size <<= 1;
+	  }
+	  mask_ = size - 1;
+	  cells_ = std::make_unique<Cell[]>(size);
+	  for (size_t i = 0; i < size; ++i) {
+		  cells_[i].seq_.store(i, std::memory_order_relaxed);
+	  }
+  }
+
+  ~MPSCQueue() = default;
+
+  // 队列满时返回 false，此时 value 不会被移走
+  bool tryPush(T &&value) {
+	  Cell *cell;
+	  auto pos = enqueuePos_.load(std::memory_order_relaxed);
+	  for (;;) {
+		  cell = &cells_[pos & mask_];
+		  auto seq = cell->seq_.load(std::memory_order_acquire);
+		  auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+		  if (diff == 0) {
+			  if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				  break;
+			  }
+		  } else if (diff < 0) {
+			  return false;
+		  } else {
+			  pos = enqueuePos_.load(std::memory_order_relaxed);
+		  }
+	  }
+	  cell->data_ = std::move(value);
+	  cell->seq_.store(pos + 1, std::memory_order_release);
+	  return true;
+  }
+
+  // 仅消费者线程调用，队列空时返回 false
+  bool tryPop(T &value) {
+	  auto &cell = cells_[dequeuePos_ & mask_];
+	  if (cell.seq_.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+		  return false;
+	  }
+	  value = std::move(cell.data_);
+	  cell.data_ = T();    // 及时释放任务捕获的资源
+	  cell.seq_.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+	  ++dequeuePos_;
+	  return true;
+  }
+
+  // 仅消费者线程调用
+  bool empty() const {
+	  return cells_[dequeuePos_ & mask_].seq_.load(std::memory_order_acquire) != dequeuePos_ + 1;
+  }
+
+ private:
+  struct Cell {
+	  std::atomic<size_t> seq_;
+	  T data_;
+  };
+
+  size_t mask_;
+  std::unique_ptr<Cell[]> cells_;
+  alignas(64) std::atomic<size_t> enqueuePos_{0};    // 生产者共享的写位置
+  alignas(64) size_t dequeuePos_ = 0;                // 消费者独占的读位置
+
+ public:
+// 删除拷贝语义
+  MPSCQueue(const MPSCQueue &other) = delete;
+  MPSCQueue &operator=(const MPSCQueue &other) = delete;
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_MPSCQUEUE_H_
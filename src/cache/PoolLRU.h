@@ -0,0 +1,149 @@
+/**
+  ******************************************************************************
+  * @file           : PoolLRU.h
+  * @author         : xy
+  * @brief          : 节点池化的 LRU cache
+  * @attention      : 节点预分配在连续数组中，通过 32 位下标链接，稳态下不再分配内存
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_POOLLRU_H_
+#define CACHE_SRC_CACHE_POOLLRU_H_
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "CachePolicy.h"
+#include "FlatMap.h"
+
+namespace Cache {
+
+/**
+ * @brief 与 LRU 语义相同，区别在于节点存储：
+ * 所有节点在构造时一次性分配在 pool_ 中，前驱、后继都用下标表示，索引中也只存下标，
+ * 没有 shared_ptr 的引用计数，也没有每个节点一次的堆分配
+ * @tparam Key
+ * @tparam Value
+ */
+template<typename Key, typename Value>
+class PoolLRU : public CachePolicy<Key, Value> {
+ public:
+  using Index = uint32_t;
+  using NodeMap = FlatMap<Key, Index>;
+  static constexpr Index kNil = UINT32_MAX;
+
+  explicit PoolLRU(size_t capacity)
+	  : capacity_(capacity), size_(0) {
+	  assert(capacity_ < kNil);
+	  init();
+  }
+
+  ~PoolLRU() = default;
+
+  void put(Key key, Value value) override {
+	  if (capacity_ <= 0) {
+		  return;
+	  }
+
+	  // 如果存在，更新节点值, 并移到头部
+	  auto it = nodeMap_.find(key);
+	  if (it != nodeMap_.end()) {
+		  pool_[it->second].value_ = std::move(value);
+		  moveToHead(it->second);
+		  return;
+	  }
+	  // 池子未满，直接取下一个空闲节点；否则复用末尾节点
+	  Index index;
+	  if (size_ < capacity_) {
+		  index = static_cast<Index>(size_++);
+	  } else {
+		  index = pool_[sentinel()].prev_;
+		  removeNode(index);
+		  nodeMap_.erase(pool_[index].key_);
+	  }
+	  auto &node = pool_[index];
+	  node.key_ = key;
+	  node.value_ = std::move(value);
+	  nodeMap_.emplace(std::move(key), index);
+	  insertNode(index);
+  }
+
+  std::optional<Value> get(const Key &key) override {
+	  return lookup(key);
+  }
+
+  // 异构查找，例如 Key 为 std::string 时可以直接用 std::string_view 查找
+  template<typename K>
+  std::optional<Value> get(const K &key) {
+	  return lookup(key);
+  }
+
+  size_t size() const { return size_; }
+
+  size_t capacity() const { return capacity_; }
+
+ private:
+  template<typename K>
+  std::optional<Value> lookup(const K &key) {
+	  auto it = nodeMap_.find(key);
+	  if (it == nodeMap_.end()) {
+		  return std::nullopt;
+	  }
+	  // 节点存在，更新到头部
+	  moveToHead(it->second);
+	  return pool_[it->second].value_;
+  }
+
+  struct PoolNode {
+	  Key key_;
+	  Value value_;
+	  Index prev_ = kNil;
+	  Index next_ = kNil;
+  };
+
+  void init() {
+	  // 最后一个节点作为虚拟头尾节点，链表首尾相连
+	  pool_.resize(capacity_ + 1);
+	  pool_[sentinel()].prev_ = sentinel();
+	  pool_[sentinel()].next_ = sentinel();
+	  // 索引一次预留到容量大小，之后的插入删除都不会扩容
+	  nodeMap_.reserve(capacity_);
+  }
+
+  Index sentinel() const { return static_cast<Index>(capacity_); }
+
+  void moveToHead(Index index) {
+	  if (pool_[sentinel()].next_ == index) return;
+	  removeNode(index);
+	  insertNode(index);
+  }
+
+  void removeNode(Index index) {
+	  auto &node = pool_[index];
+	  pool_[node.prev_].next_ = node.next_;
+	  pool_[node.next_].prev_ = node.prev_;
+	  node.prev_ = kNil;
+	  node.next_ = kNil;
+  }
+
+  void insertNode(Index index) {
+	  auto &head = pool_[sentinel()];
+	  auto &node = pool_[index];
+	  node.next_ = head.next_;
+	  node.prev_ = sentinel();
+	  pool_[head.next_].prev_ = index;
+	  head.next_ = index;
+  }
+
+ private:
+  size_t capacity_;                // 缓存容量，超过容量触发淘汰机制
+  size_t size_;                    // 已使用的节点数
+  std::vector<PoolNode> pool_;    // 节点池，最后一个为虚拟节点
+  NodeMap nodeMap_;                // key 到节点下标
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_POOLLRU_H_
@@ -0,0 +1,271 @@
+/**
+  ******************************************************************************
+  * @file           : RcuIndex.h
+  * @author         : xy
+  * @brief          : 读操作不加锁的定长哈希索引，记录按 RCU 方式延迟释放
+  * @attention      : 读者进入 RcuDomain::Guard 后调用 find；写操作（insert、replace、erase、retire）由调用方串行化
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_RCUINDEX_H_
+#define CACHE_SRC_CACHE_RCUINDEX_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "FlatMap.h"
+
+namespace Cache {
+
+/**
+ * @brief 读者登记与宽限期。读者按线程分到 kSlots 个槽位之一，进出时只对自己槽位中当前阶段的计数加减一，
+ * 不同线程写的是不同的缓存行，读者之间没有共享的读-改-写；槽位数超过线程数时才会有线程共用一个槽位。
+ * 写者在 synchronize 中翻转阶段，再等待旧阶段的计数全部归零，此后翻转前摘下的对象不会再被任何读者访问
+ */
+class RcuDomain {
+  static constexpr size_t kSlots = 64;
+ public:
+  class Guard {
+   public:
+	explicit Guard(const RcuDomain &domain) : counter_(domain.enter()) {}
+
+	~Guard() { counter_->fetch_sub(1, std::memory_order_release); }
+
+	Guard(const Guard &other) = delete;
+	Guard &operator=(const Guard &other) = delete;
+
+   private:
+	std::atomic<uint64_t> *counter_;
+  };
+
+  RcuDomain() = default;
+
+  ~RcuDomain() = default;
+
+  // 等待翻转阶段前进入的读者全部退出，由写者调用
+  void synchronize() {
+	  auto old = phase_.load(std::memory_order_relaxed);
+	  phase_.store(old ^ 1, std::memory_order_seq_cst);
+	  for (auto &slot : slots_) {
+		  while (slot.count_[old].load(std::memory_order_seq_cst) != 0) {
+			  std::this_thread::yield();
+		  }
+	  }
+  }
+
+ private:
+  struct alignas(64) Slot {
+	  mutable std::atomic<uint64_t> count_[2] = {0, 0};    // 两个阶段各自的读者数
+  };
+
+  // 在当前阶段登记；登记后阶段已被翻转则撤销重来，保证写者等待时能看到这次登记
+  std::atomic<uint64_t> *enter() const {
+	  auto &slot = slots_[threadSlot()];
+	  while (true) {
+		  auto phase = phase_.load(std::memory_order_seq_cst);
+		  slot.count_[phase].fetch_add(1, std::memory_order_seq_cst);
+		  if (phase_.load(std::memory_order_seq_cst) == phase) {
+			  return &slot.count_[phase];
+		  }
+		  slot.count_[phase].fetch_sub(1, std::memory_order_release);
+	  }
+  }
+
+  // 线程第一次读时分配槽位，之后不变
+  static size_t threadSlot() {
+	  static std::atomic<size_t> next{0};
+	  thread_local size_t slot = next.fetch_add(1, std::memory_order_relaxed) % kSlots;
+	  return slot;
+  }
+
+ private:
+  Slot slots_[kSlots];
+  alignas(64) std::atomic<uint32_t> phase_{0};    // 当前阶段，写者翻转，读者只读
+
+ public:
+// 删除拷贝语义
+  RcuDomain(const RcuDomain &other) = delete;
+  RcuDomain &operator=(const RcuDomain &other) = delete;
+};
+
+/**
+ * @brief 线性探测的哈希表，槽位是指向记录的原子指针，记录本身在发布后不再修改（原子成员除外）。
+ * 槽位数固定为容量两倍以上，不需要扩容；删除留下墓碑，墓碑过多时写者重建一张新表再原子地替换。
+ * 被替换、删除的记录与旧表先交给 retire，攒够一批后经过一次宽限期统一释放，读者持有的指针始终有效。
+ * 读者与写者同时操作同一个 key 时，读者看到的是替换前或替换后的记录之一
+ * @tparam Key
+ * @tparam Record 带有 key_ 成员的记录类型，由本索引负责释放
+ */
+template<typename Key, typename Record, typename Hash = CacheHash<Key>, typename KeyEqual = std::equal_to<>>
+class RcuIndex {
+  static constexpr size_t kRetireBatch = 64;    // 攒够这么多待释放的记录才等待一次宽限期
+ public:
+  using Guard = RcuDomain::Guard;
+
+  explicit RcuIndex(size_t capacity) : live_(0), used_(0) {
+	  size_t size = 16;
+	  while (size < 2 * capacity) {
+		  size <<= 1;
+	  }
+	  table_.store(new Table(size), std::memory_order_relaxed);
+  }
+
+  // 析构时不应再有读者，直接释放所有记录
+  ~RcuIndex() {
+	  auto table = table_.load(std::memory_order_relaxed);
+	  for (size_t i = 0; i <= table->mask_; ++i) {
+		  auto record = table->slots_[i].load(std::memory_order_relaxed);
+		  if (record != nullptr && record != tombstone()) {
+			  delete record;
+		  }
+	  }
+	  delete table;
+	  reclaim();
+  }
+
+  // 读者用 Guard 包住 find 与对记录的访问
+  Guard read() const { return Guard(domain_); }
+
+  // 读者须持有 Guard，写者在串行化的写操作中可以直接调用
+  template<typename K>
+  Record *find(const K &key) const {
+	  auto table = table_.load(std::memory_order_acquire);
+	  auto index = hashOf(key) & table->mask_;
+	  for (size_t probe = 0; probe <= table->mask_; ++probe) {
+		  auto record = table->slots_[index].load(std::memory_order_acquire);
+		  if (record == nullptr) {
+			  return nullptr;
+		  }
+		  if (record != tombstone() && KeyEqual{}(record->key_, key)) {
+			  return record;
+		  }
+		  index = (index + 1) & table->mask_;
+	  }
+	  return nullptr;
+  }
+
+  size_t size() const { return live_; }
+
+  // 插入不存在的 key 的记录，发布后读者即可看到
+  void insert(Record *record) {
+	  auto table = table_.load(std::memory_order_relaxed);
+	  if (used_ + 1 > (table->mask_ + 1) / 4 * 3) {
+		  rebuild();
+		  table = table_.load(std::memory_order_relaxed);
+	  }
+	  auto index = hashOf(record->key_) & table->mask_;
+	  while (true) {
+		  auto slot = table->slots_[index].load(std::memory_order_relaxed);
+		  if (slot == nullptr || slot == tombstone()) {
+			  used_ += slot == nullptr;
+			  table->slots_[index].store(record, std::memory_order_release);
+			  ++live_;
+			  return;
+		  }
+		  index = (index + 1) & table->mask_;
+	  }
+  }
+
+  // 用 record 替换同一个 key 的旧记录，旧记录延迟释放
+  void replace(Record *old, Record *record) {
+	  slotOf(old)->store(record, std::memory_order_release);
+	  retire(old);
+  }
+
+  // 删除记录，留下墓碑，记录延迟释放
+  void erase(Record *record) {
+	  slotOf(record)->store(tombstone(), std::memory_order_release);
+	  --live_;
+	  retire(record);
+  }
+
+ private:
+  struct Table {
+	  explicit Table(size_t size)
+		  : mask_(size - 1), slots_(std::make_unique<std::atomic<Record *>[]>(size)) {
+		  for (size_t i = 0; i < size; ++i) {
+			  slots_[i].store(nullptr, std::memory_order_relaxed);
+		  }
+	  }
+
+	  size_t mask_;
+	  std::unique_ptr<std::atomic<Record *>[]> slots_;
+  };
+
+  // 墓碑只作标记，不会被解引用
+  static Record *tombstone() { return reinterpret_cast<Record *>(uintptr_t(1)); }
+
+  // 与 FlatMap 相同，先打散再取低位
+  template<typename K>
+  static size_t hashOf(const K &key) {
+	  uint64_t hash = static_cast<uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ULL;
+	  return static_cast<size_t>(hash ^ (hash >> 32));
+  }
+
+  std::atomic<Record *> *slotOf(Record *record) {
+	  auto table = table_.load(std::memory_order_relaxed);
+	  auto index = hashOf(record->key_) & table->mask_;
+	  while (table->slots_[index].load(std::memory_order_relaxed) != record) {
+		  index = (index + 1) & table->mask_;
+	  }
+	  return &table->slots_[index];
+  }
+
+  // 墓碑过多时把存活记录搬到一张同样大小的新表，旧表延迟释放
+  void rebuild() {
+	  auto old = table_.load(std::memory_order_relaxed);
+	  auto table = new Table(old->mask_ + 1);
+	  for (size_t i = 0; i <= old->mask_; ++i) {
+		  auto record = old->slots_[i].load(std::memory_order_relaxed);
+		  if (record == nullptr || record == tombstone()) {
+			  continue;
+		  }
+		  auto index = hashOf(record->key_) & table->mask_;
+		  while (table->slots_[index].load(std::memory_order_relaxed) != nullptr) {
+			  index = (index + 1) & table->mask_;
+		  }
+		  table->slots_[index].store(record, std::memory_order_relaxed);
+	  }
+	  table_.store(table, std::memory_order_release);
+	  used_ = live_;
+	  retiredTables_.emplace_back(old);
+  }
+
+  void retire(Record *record) {
+	  retired_.push_back(record);
+	  if (retired_.size() >= kRetireBatch) {
+		  domain_.synchronize();
+		  reclaim();
+	  }
+  }
+
+  void reclaim() {
+	  for (auto record : retired_) {
+		  delete record;
+	  }
+	  retired_.clear();
+	  retiredTables_.clear();
+  }
+
+ private:
+  std::atomic<Table *> table_;                    // 当前的表，重建时整体替换
+  size_t live_;                                    // 存活的记录数
+  size_t used_;                                    // 非空槽位数，包括墓碑
+  std::vector<Record *> retired_;                // 等待宽限期后释放的记录
+  std::vector<std::unique_ptr<Table>> retiredTables_;    // 等待宽限期后释放的旧表
+  RcuDomain domain_;
+
+ public:
+// 删除拷贝语义
+  RcuIndex(const RcuIndex &other) = delete;
+  RcuIndex &operator=(const RcuIndex &other) = delete;
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_RCUINDEX_H_
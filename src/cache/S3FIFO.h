@@ -0,0 +1,175 @@
+/**
+  ******************************************************************************
+  * @file           : S3FIFO.h
+  * @author         : xy
+  * @brief          : S3-FIFO 淘汰策略：小 FIFO + 主 FIFO + 幽灵 FIFO
+  * @attention      : get 不加锁：经 RcuIndex 查找后只原子地增加 2 位频次计数；put 由互斥锁串行化
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_S3FIFO_H_
+#define CACHE_SRC_CACHE_S3FIFO_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "CachePolicy.h"
+#include "GhostQueue.h"
+#include "IndexList.h"
+#include "RcuIndex.h"
+
+namespace Cache {
+
+/**
+ * @brief 新条目先进入占容量 10% 的小队列 S，其余容量为主队列 M，每个条目有一个 0 ~ 3 的频次计数。
+ * S 淘汰时，尾部条目在 S 中被访问过就移入 M，否则淘汰并把 key 记入幽灵队列 G；
+ * M 淘汰时，尾部条目频次不为 0 就减一后放回 M 头部，否则淘汰；
+ * 写入的 key 在 G 中说明它刚被过早淘汰，直接进入 M。大多数一次性访问的条目在 S 中很快被淘汰，不会进入 M。
+ * 与 Sieve 相同，key、value 与频次计数放在 RcuIndex 管理的记录中，读者不加锁查找，更新 value 时换上新记录
+ * @tparam Key
+ * @tparam Value
+ */
+template<typename Key, typename Value>
+class S3FIFO : public CachePolicy<Key, Value> {
+  using Index = uint32_t;
+  static constexpr Index kNil = UINT32_MAX;
+  static constexpr uint8_t kMaxFreq = 3;
+
+  struct Record {
+	  Record(Key key, Value value, uint8_t freq, Index node)
+		  : key_(std::move(key)), value_(std::move(value)), freq_(freq), node_(node) {}
+
+	  const Key key_;
+	  const Value value_;
+	  std::atomic<uint8_t> freq_;    // 频次计数，最大 kMaxFreq
+	  const Index node_;            // 所在节点的下标
+  };
+ public:
+  explicit S3FIFO(size_t capacity)
+	  : capacity_(capacity), size_(0), nodes_(capacity), index_(capacity), ghost_(capacity) {
+	  smallCapacity_ = std::max<size_t>(capacity_ / 10, 1);
+  }
+
+  ~S3FIFO() = default;
+
+  void put(Key key, Value value) override {
+	  if (capacity_ <= 0) {
+		  return;
+	  }
+
+	  std::lock_guard<std::mutex> lock(mutex_);
+	  // 如果存在，换上带新值的记录，按一次命中处理
+	  if (auto old = index_.find(key)) {
+		  auto record = new Record(std::move(key), std::move(value), old->freq_.load(std::memory_order_relaxed), old->node_);
+		  touch(*record);
+		  nodes_[old->node_].record_ = record;
+		  index_.replace(old, record);
+		  return;
+	  }
+
+	  // 刚被淘汰过的 key 直接进入主队列
+	  auto queue = ghost_.take(key) ? kMain : kSmall;
+	  auto size = size_.load(std::memory_order_relaxed);
+	  Index index = size < capacity_ ? static_cast<Index>(size) : evict();
+	  if (size < capacity_) {
+		  size_.store(size + 1, std::memory_order_relaxed);
+	  }
+	  auto record = new Record(std::move(key), std::move(value), 0, index);
+	  nodes_[index].record_ = record;
+	  index_.insert(record);
+	  nodes_.link(index, queue);
+  }
+
+  std::optional<Value> get(const Key &key) override {
+	  auto guard = index_.read();
+	  auto record = index_.find(key);
+	  if (record == nullptr) {
+		  return std::nullopt;
+	  }
+	  touch(*record);
+	  return record->value_;
+  }
+
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+ private:
+  enum Queue : uint8_t {
+	kSmall = 0,
+	kMain = 1,
+	kQueues = 2
+  };
+
+  // 队列节点只由写者访问
+  struct Node {
+	  Record *record_ = nullptr;        // 当前的记录，由 index_ 负责释放
+	  Index prev_ = kNil;                // 靠近头部的相邻节点
+	  Index next_ = kNil;                // 靠近尾部的相邻节点
+	  Queue list_ = kSmall;
+  };
+
+  // 频次加一，饱和后不再写；并发的读、或与替换记录的 put 并发时可能丢失一次加一，只影响近似的频次
+  static void touch(Record &record) {
+	  auto freq = record.freq_.load(std::memory_order_relaxed);
+	  if (freq < kMaxFreq) {
+		  record.freq_.store(freq + 1, std::memory_order_relaxed);
+	  }
+  }
+
+  // 腾出一个节点，返回其下标，调用方持有写锁
+  Index evict() {
+	  while (true) {
+		  if (nodes_.count(kSmall) >= smallCapacity_ || nodes_.count(kMain) == 0) {
+			  auto index = nodes_.tail(kSmall);
+			  nodes_.unlink(index);
+			  auto record = nodes_[index].record_;
+			  // 在 S 中被访问过，移入 M
+			  if (record->freq_.load(std::memory_order_relaxed) > 0) {
+				  record->freq_.store(0, std::memory_order_relaxed);
+				  nodes_.link(index, kMain);
+				  continue;
+			  }
+			  ghost_.push(record->key_);
+			  release(index);
+			  return index;
+		  }
+		  auto index = nodes_.tail(kMain);
+		  nodes_.unlink(index);
+		  auto record = nodes_[index].record_;
+		  auto freq = record->freq_.load(std::memory_order_relaxed);
+		  if (freq > 0) {
+			  record->freq_.store(freq - 1, std::memory_order_relaxed);
+			  nodes_.link(index, kMain);
+			  continue;
+		  }
+		  release(index);
+		  return index;
+	  }
+  }
+
+  // 从索引删除节点的记录，记录等读者退出后释放
+  void release(Index index) {
+	  index_.erase(nodes_[index].record_);
+	  nodes_[index].record_ = nullptr;
+  }
+
+ private:
+  size_t capacity_;                        // 缓存容量
+  size_t smallCapacity_;                // 小队列 S 的容量
+  std::atomic<size_t> size_;                // 已使用的节点数，写者修改，读者只读
+  IndexList<Node, Queue, kQueues> nodes_;    // 节点数组，两个队列的链表与各队列条目数
+  RcuIndex<Key, Record> index_;            // key 到记录，读者不加锁查找
+  GhostQueue<Key> ghost_;                // 幽灵队列，容量与缓存相同
+  std::mutex mutex_;                    // 串行化写操作，读操作不使用
+
+ public:
+// 删除拷贝语义
+  S3FIFO(const S3FIFO &other) = delete;
+  S3FIFO &operator=(const S3FIFO &other) = delete;
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_S3FIFO_H_
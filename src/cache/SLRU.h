@@ -0,0 +1,129 @@
+/**
+  ******************************************************************************
+  * @file           : SLRU.h
+  * @author         : xy
+  * @brief          : 分段 LRU（Segmented LRU）：试用段 + 保护段
+  * @attention      : 不加锁；节点预分配在连续数组中，命中与淘汰都不分配内存
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_SLRU_H_
+#define CACHE_SRC_CACHE_SLRU_H_
+
+#include <cassert>
+#include <cstdint>
+
+#include "CachePolicy.h"
+#include "FlatMap.h"
+#include "IndexList.h"
+
+namespace Cache {
+
+/**
+ * @brief 新条目进入试用段头部，在试用段中再次命中才晋升到保护段，保护段超出容量时尾部降回试用段头部。
+ * 淘汰总是从试用段尾部开始，只被访问一次的条目（例如一次全量扫描）只能在试用段里互相挤出，
+ * 不会冲掉保护段中的热点。保护段占总容量的比例由 protectedRatio 指定
+ * @tparam Key
+ * @tparam Value
+ */
+template<typename Key, typename Value>
+class SLRU : public CachePolicy<Key, Value> {
+  using Index = uint32_t;
+  using NodeMap = FlatMap<Key, Index>;
+ public:
+  explicit SLRU(size_t capacity, double protectedRatio = 0.8)
+	  : capacity_(capacity), size_(0), pool_(capacity) {
+	  assert(protectedRatio >= 0 && protectedRatio < 1);
+	  protectedCapacity_ = static_cast<size_t>(capacity_ * protectedRatio);
+	  nodeMap_.reserve(capacity_);
+  }
+
+  ~SLRU() = default;
+
+  void put(Key key, Value value) override {
+	  if (capacity_ <= 0) {
+		  return;
+	  }
+
+	  // 如果存在，更新节点值，按一次命中处理
+	  auto it = nodeMap_.find(key);
+	  if (it != nodeMap_.end()) {
+		  pool_[it->second].value_ = std::move(value);
+		  onHit(it->second);
+		  return;
+	  }
+
+	  Index index = size_ < capacity_ ? static_cast<Index>(size_++) : evict();
+	  auto &node = pool_[index];
+	  node.key_ = key;
+	  node.value_ = std::move(value);
+	  nodeMap_.emplace(std::move(key), index);
+	  pool_.link(index, kProbation);
+  }
+
+  std::optional<Value> get(const Key &key) override {
+	  auto it = nodeMap_.find(key);
+	  if (it == nodeMap_.end()) {
+		  return std::nullopt;
+	  }
+	  onHit(it->second);
+	  return pool_[it->second].value_;
+  }
+
+  size_t size() const { return size_; }
+
+  size_t capacity() const { return capacity_; }
+
+ private:
+  // 两个段各是节点池中的一条链表
+  enum Segment : uint8_t {
+	kProbation = 0,
+	kProtected = 1,
+	kSegments = 2
+  };
+
+  struct PoolNode {
+	  Key key_;
+	  Value value_;
+	  Index prev_ = 0;
+	  Index next_ = 0;
+	  Segment list_ = kProbation;
+  };
+
+  void onHit(Index index) {
+	  // 保护段容量为 0 时退化为普通 LRU
+	  if (protectedCapacity_ == 0) {
+		  pool_.move(index, kProbation);
+		  return;
+	  }
+	  pool_.move(index, kProtected);
+	  if (pool_.count(kProtected) > protectedCapacity_) {
+		  pool_.move(pool_.tail(kProtected), kProbation);
+	  }
+  }
+
+  // 缓存已满时腾出一个节点：试用段尾部，试用段为空时取保护段尾部
+  Index evict() {
+	  Index evicted = pool_.count(kProbation) ? pool_.tail(kProbation) : pool_.tail(kProtected);
+	  pool_.unlink(evicted);
+	  nodeMap_.erase(pool_[evicted].key_);
+	  return evicted;
+  }
+
+ private:
+  size_t capacity_;                    // 缓存容量
+  size_t protectedCapacity_;        // 保护段容量
+  size_t size_;                        // 已使用的节点数
+  IndexList<PoolNode, Segment, kSegments> pool_;    // 节点池，两个段的链表与各段条目数
+  NodeMap nodeMap_;                    // key 到节点下标
+
+ public:
+// 删除拷贝语义
+  SLRU(const SLRU &other) = delete;
+  SLRU &operator=(const SLRU &other) = delete;
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_SLRU_H_
@@ -0,0 +1,114 @@
+/**
+  ******************************************************************************
+  * @file           : ShardedCache.h
+  * @author         : xy
+  * @brief          : 分片加锁的并发缓存
+  * @attention      : get/put 直接在调用线程执行，不经过工作线程
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_SHARDEDCACHE_H_
+#define CACHE_SRC_CACHE_SHARDEDCACHE_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "CachePolicy.h"
+#include "PoolLRU.h"
+
+namespace Cache {
+
+/**
+ * @brief 按 key 的哈希把缓存拆成若干分片，每个分片一把锁、一个独立的缓存策略实例
+ * 不同分片上的操作互不阻塞，调用方线程直接访问分片，没有任务队列和线程切换。
+ * 分片数不超过容量，各分片容量之和等于总容量
+ * @tparam Key
+ * @tparam Value
+ * @tparam Policy 分片使用的缓存策略，构造参数为 (分片容量, args...)
+ */
+template<typename Key, typename Value, typename Policy>
+class ShardedCache : public CachePolicy<Key, Value> {
+ public:
+  /**
+   * @param capacity 总容量
+   * @param shardNum 期望的分片数，向上取整为 2 的幂；超过容量时按 2 的幂向下收缩到不大于容量，
+   * 容量为 0 时只有一个分片。实际分片数由 shardNum() 返回
+   * @param args 构造每个分片策略时附加的参数
+   */
+  template<typename... Args>
+  ShardedCache(size_t capacity, size_t shardNum, Args &&... args)
+	  : capacity_(capacity), shardBits_(0) {
+	  // 分片数向上取整为 2 的幂，方便用哈希高位选分片；
+	  // 但不超过容量（按 2 的幂向下取），否则会出现容量为 0 的分片
+	  while ((size_t(1) << shardBits_) < shardNum) {
+		  ++shardBits_;
+	  }
+	  while (shardBits_ > 0 && (size_t(1) << shardBits_) > capacity) {
+		  --shardBits_;
+	  }
+	  shardNum_ = size_t(1) << shardBits_;
+	  // 容量按分片数均分，余数分给前面的分片，各分片容量之和正好等于 capacity
+	  auto shardCapacity = capacity / shardNum_;
+	  auto remainder = capacity % shardNum_;
+	  shards_ = std::make_unique<Shard[]>(shardNum_);
+	  for (size_t i = 0; i < shardNum_; ++i) {
+		  shards_[i].cache_ = std::make_unique<Policy>(shardCapacity + (i < remainder ? 1 : 0), args...);
+	  }
+  }
+
+  ~ShardedCache() = default;
+
+  void put(Key key, Value value) override {
+	  auto &shard = shardOf(key);
+	  std::lock_guard<std::mutex> lock(shard.mutex_);
+	  shard.cache_->put(std::move(key), std::move(value));
+  }
+
+  std::optional<Value> get(const Key &key) override {
+	  auto &shard = shardOf(key);
+	  std::lock_guard<std::mutex> lock(shard.mutex_);
+	  return shard.cache_->get(key);
+  }
+
+  size_t shardNum() const { return shardNum_; }
+
+  // 各分片容量之和
+  size_t capacity() const { return capacity_; }
+
+ private:
+  // 每个分片独占缓存行，避免相邻分片的锁发生伪共享
+  struct alignas(64) Shard {
+	  std::mutex mutex_;
+	  std::unique_ptr<Policy> cache_;
+  };
+
+  Shard &shardOf(const Key &key) {
+	  if (shardBits_ == 0) {
+		  return shards_[0];
+	  }
+	  // 分片内部的哈希表使用哈希低位，这里先打散再取高位，两者互不相关
+	  uint64_t hash = static_cast<uint64_t>(std::hash<Key>{}(key)) * 0x9E3779B97F4A7C15ULL;
+	  return shards_[hash >> (64 - shardBits_)];
+  }
+
+ public:
+// 删除拷贝语义
+  ShardedCache(const ShardedCache &other) = delete;
+  ShardedCache &operator=(const ShardedCache &other) = delete;
+ private:
+  size_t capacity_;
+  size_t shardBits_;
+  size_t shardNum_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
+// 分片 LRU，每个分片是一个节点池化的 PoolLRU
+template<typename Key, typename Value>
+using ShardedLRU = ShardedCache<Key, Value, PoolLRU<Key, Value>>;
+
+}
+
+#endif //CACHE_SRC_CACHE_SHARDEDCACHE_H_
@@ -0,0 +1,161 @@
+/**
+  ******************************************************************************
+  * @file           : Sieve.h
+  * @author         : xy
+  * @brief          : SIEVE 淘汰策略
+  * @attention      : get 不加锁：经 RcuIndex 查找后只原子地设置访问位；put 由互斥锁串行化
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_SIEVE_H_
+#define CACHE_SRC_CACHE_SIEVE_H_
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "CachePolicy.h"
+#include "RcuIndex.h"
+
+namespace Cache {
+
+/**
+ * @brief 条目按插入先后排成一条 FIFO 队列，新条目插入头部，命中只置位访问位。
+ * 需要淘汰时，指针从上次停下的位置向头部移动：访问位为 1 的清零并跳过，遇到为 0 的即淘汰，走到头部后回到尾部。
+ * 与 CLOCK 的区别是被跳过的条目留在原位，不会被移到头部，新条目与存活下来的老条目自然分开，
+ * 一次性访问的条目很快被淘汰。
+ * key、value 与访问位放在发布后不再修改的记录中，读者在 RcuIndex 中查找记录，不持有任何锁，
+ * 只在自己的读者槽位上计数；更新 value 时换上一条新记录，旧记录等读者退出后才释放
+ * @tparam Key
+ * @tparam Value
+ */
+template<typename Key, typename Value>
+class Sieve : public CachePolicy<Key, Value> {
+  using Index = uint32_t;
+  static constexpr Index kNil = UINT32_MAX;
+
+  struct Record {
+	  Record(Key key, Value value, bool visited, Index node)
+		  : key_(std::move(key)), value_(std::move(value)), visited_(visited), node_(node) {}
+
+	  const Key key_;
+	  const Value value_;
+	  std::atomic<bool> visited_;    // 访问位
+	  const Index node_;            // 所在节点的下标
+  };
+ public:
+  explicit Sieve(size_t capacity)
+	  : capacity_(capacity), size_(0), hand_(kNil), nodes_(std::make_unique<Node[]>(capacity + 1)), index_(capacity) {
+	  assert(capacity_ < kNil);
+	  // 最后一个节点作为虚拟头尾节点
+	  nodes_[sentinel()].newer_ = sentinel();
+	  nodes_[sentinel()].older_ = sentinel();
+  }
+
+  ~Sieve() = default;
+
+  void put(Key key, Value value) override {
+	  if (capacity_ <= 0) {
+		  return;
+	  }
+
+	  std::lock_guard<std::mutex> lock(mutex_);
+	  // 如果存在，换上带新值的记录，并置位访问位
+	  if (auto old = index_.find(key)) {
+		  auto record = new Record(std::move(key), std::move(value), true, old->node_);
+		  nodes_[old->node_].record_ = record;
+		  index_.replace(old, record);
+		  return;
+	  }
+
+	  auto size = size_.load(std::memory_order_relaxed);
+	  Index index = size < capacity_ ? static_cast<Index>(size) : evict();
+	  if (size < capacity_) {
+		  size_.store(size + 1, std::memory_order_relaxed);
+	  }
+	  auto record = new Record(std::move(key), std::move(value), false, index);
+	  nodes_[index].record_ = record;
+	  index_.insert(record);
+	  insertHead(index);
+  }
+
+  std::optional<Value> get(const Key &key) override {
+	  auto guard = index_.read();
+	  auto record = index_.find(key);
+	  if (record == nullptr) {
+		  return std::nullopt;
+	  }
+	  // 已经置位就不再写，避免热点条目所在缓存行在读线程之间来回失效；
+	  // 与替换记录的 put 并发时可能置位在旧记录上，只影响近似的访问位
+	  if (!record->visited_.load(std::memory_order_relaxed)) {
+		  record->visited_.store(true, std::memory_order_relaxed);
+	  }
+	  return record->value_;
+  }
+
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+ private:
+  // 链表节点只由写者访问
+  struct Node {
+	  Record *record_ = nullptr;            // 当前的记录，由 index_ 负责释放
+	  Index newer_ = kNil;                    // 靠近头部（更晚插入）的相邻节点
+	  Index older_ = kNil;                    // 靠近尾部（更早插入）的相邻节点
+  };
+
+  Index sentinel() const { return static_cast<Index>(capacity_); }
+
+  void insertHead(Index index) {
+	  auto &head = nodes_[sentinel()];
+	  auto &node = nodes_[index];
+	  node.older_ = head.older_;
+	  node.newer_ = sentinel();
+	  nodes_[head.older_].newer_ = index;
+	  head.older_ = index;
+  }
+
+  void unlink(Index index) {
+	  auto &node = nodes_[index];
+	  nodes_[node.newer_].older_ = node.older_;
+	  nodes_[node.older_].newer_ = node.newer_;
+  }
+
+  // 从指针位置向头部寻找访问位为 0 的节点淘汰，返回空出的下标，调用方持有写锁
+  Index evict() {
+	  auto hand = hand_ == kNil ? nodes_[sentinel()].newer_ : hand_;
+	  while (nodes_[hand].record_->visited_.load(std::memory_order_relaxed)) {
+		  nodes_[hand].record_->visited_.store(false, std::memory_order_relaxed);
+		  hand = nodes_[hand].newer_;
+		  // 走到头部，回到尾部继续
+		  if (hand == sentinel()) {
+			  hand = nodes_[sentinel()].newer_;
+		  }
+	  }
+	  auto next = nodes_[hand].newer_;
+	  hand_ = next == sentinel() ? kNil : next;
+	  unlink(hand);
+	  index_.erase(nodes_[hand].record_);
+	  nodes_[hand].record_ = nullptr;
+	  return hand;
+  }
+
+ private:
+  size_t capacity_;                    // 缓存容量
+  std::atomic<size_t> size_;            // 已使用的节点数，写者修改，读者只读
+  Index hand_;                        // 淘汰指针，kNil 表示从尾部开始
+  std::unique_ptr<Node[]> nodes_;    // 节点数组，最后一个为虚拟节点
+  RcuIndex<Key, Record> index_;        // key 到记录，读者不加锁查找
+  std::mutex mutex_;                // 串行化写操作，读操作不使用
+
+ public:
+// 删除拷贝语义
+  Sieve(const Sieve &other) = delete;
+  Sieve &operator=(const Sieve &other) = delete;
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_SIEVE_H_
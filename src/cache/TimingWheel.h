@@ -0,0 +1,267 @@
+/**
+  ******************************************************************************
+  * @file           : TimingWheel.h
+  * @author         : xy
+  * @brief          : 分层时间轮，管理缓存条目的过期时间
+  * @attention      : 不加锁，由所属缓存在自己的操作中推进（协作式 tick）
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_TIMINGWHEEL_H_
+#define CACHE_SRC_CACHE_TIMINGWHEEL_H_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace Cache {
+
+/**
+ * @brief 侵入式定时器挂钩，缓存节点继承它即可挂到时间轮上，不需要额外分配内存。
+ * expireAt_ 为过期的 tick，未设置过期时间时为 kNever；命中没有过期时间的节点只需判断一次 scheduled()
+ */
+struct TimerHook {
+  static constexpr uint64_t kNever = UINT64_MAX;
+
+  TimerHook *timerPrev_ = nullptr;
+  TimerHook *timerNext_ = nullptr;
+  uint64_t expireAt_ = kNever;
+
+  bool scheduled() const { return timerPrev_ != nullptr; }
+
+  // 在当前 tick 是否已经过期
+  bool expired(uint64_t now) const { return expireAt_ <= now; }
+
+  void unlink() {
+	  timerPrev_->timerNext_ = timerNext_;
+	  timerNext_->timerPrev_ = timerPrev_;
+	  timerPrev_ = nullptr;
+	  timerNext_ = nullptr;
+  }
+};
+
+/**
+ * @brief 分层时间轮：4 层，每层 64 个槽，第 0 层每槽一个 tick，上一层每槽覆盖下一层一整圈。
+ * 定时器按剩余时间放到对应层，插入、取消都是 O(1)；时间推进时按各层非空槽的掩码直接跳到下一个要处理的槽，
+ * 第 0 层转完一圈才把上一层的一个槽降级分散到下层，每个定时器最多被降级 3 次，因此均摊 O(1)，不需要扫描。
+ * 超出最高层范围的定时器先放在最高层，到期前再重新计算位置
+ * @tparam Node 继承自 TimerHook 的节点类型
+ */
+template<typename Node>
+class TimingWheel {
+  static constexpr int kLevels = 4;
+  static constexpr int kSlotBits = 6;
+  static constexpr uint64_t kSlots = 1 << kSlotBits;
+  static constexpr uint64_t kSlotMask = kSlots - 1;
+  static constexpr uint64_t kMaxSpan = uint64_t(1) << (kSlotBits * kLevels);
+  static constexpr uint32_t kSampleInterval = 64;    // 读路径每多少次调用 sample() 推进一次，须为 2 的幂
+  using Clock = std::chrono::steady_clock;
+ public:
+  explicit TimingWheel(std::chrono::milliseconds resolution = std::chrono::milliseconds(1))
+	  : resolution_(resolution), now_(clockTick()), size_(0), samples_(0) {
+	  for (auto &level : wheel_) {
+		  for (auto &slot : level) {
+			  slot.timerPrev_ = &slot;
+			  slot.timerNext_ = &slot;
+		  }
+	  }
+  }
+
+  ~TimingWheel() = default;
+
+  // 最近一次推进到的 tick，与节点的 expireAt_ 比较判断是否过期
+  uint64_t now() const { return now_; }
+
+  // 按时钟读取当前 tick，不推进时间轮，供不能修改缓存的只读访问判断过期
+  uint64_t current() const { return clockTick(); }
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  // 读路径的采样节奏：每 kSampleInterval 次调用返回一次 true，此时才推进时间轮，其余调用不读时钟
+  bool sample() { return (++samples_ & (kSampleInterval - 1)) == 0; }
+
+  // 设置 ttl 后过期，已挂在时间轮上的节点会先取消原来的定时
+  void schedule(Node *node, std::chrono::nanoseconds ttl) {
+	  if (node->scheduled()) {
+		  cancel(node);
+	  }
+	  // 时间轮为空时没有推进，先对齐到当前时间
+	  if (size_ == 0) {
+		  now_ = clockTick();
+	  }
+	  // 向上取整到 tick，保证不会提前过期；不先相加，ttl 接近 nanoseconds::max() 时也不会溢出
+	  auto ticks = ttl / resolution_;
+	  if (ttl % resolution_ > std::chrono::nanoseconds(0)) {
+		  ++ticks;
+	  }
+	  node->expireAt_ = now_ + static_cast<uint64_t>(ticks < 1 ? 1 : ticks);
+	  place(node);
+	  ++size_;
+  }
+
+  // 按时钟计算节点距过期还剩多久，已过期时为 0，精度为一个 tick
+  std::chrono::nanoseconds remaining(const Node *node) const {
+	  auto now = clockTick();
+	  return node->expireAt_ > now ? resolution_ * (node->expireAt_ - now) : std::chrono::nanoseconds(0);
+  }
+
+  // 取消定时，节点变为永不过期
+  void cancel(Node *node) {
+	  if (!node->scheduled()) {
+		  return;
+	  }
+	  node->unlink();
+	  node->expireAt_ = TimerHook::kNever;
+	  --size_;
+  }
+
+  /**
+   * @brief 推进到当前时间，对每个过期节点调用 onExpire，回调前节点已经从时间轮上摘下
+   * @param onExpire 形如 void(Node *)，可以在回调中释放节点
+   */
+  template<typename F>
+  void advance(F &&onExpire) {
+	  auto target = clockTick();
+	  if (size_ == 0) {
+		  now_ = target;
+		  return;
+	  }
+	  while (now_ < target) {
+		  // 直接跳到下一个有定时器要处理的 tick，空槽不逐个走过，空闲很久后推进的开销与经过的时间无关
+		  auto next = nextEvent();
+		  if (next > target) {
+			  now_ = target;
+			  break;
+		  }
+		  now_ = next;
+		  // 第 0 层转完一圈，把上层对应的槽降级到下层，逐层向上
+		  for (int level = 1; level < kLevels && indexOf(now_, level - 1) == 0; ++level) {
+			  cascade(level, indexOf(now_, level));
+		  }
+		  expireSlot(0, now_ & kSlotMask, onExpire);
+		  // 全部过期后直接跳到目标时间
+		  if (size_ == 0) {
+			  now_ = target;
+		  }
+	  }
+  }
+
+ private:
+  uint64_t clockTick() const {
+	  auto elapsed = Clock::now().time_since_epoch();
+	  return static_cast<uint64_t>(elapsed / resolution_);
+  }
+
+  static uint64_t indexOf(uint64_t tick, int level) {
+	  return (tick >> (kSlotBits * level)) & kSlotMask;
+  }
+
+  /**
+   * @brief 下一个需要处理的 tick：第 0 层是非空槽本身的 tick，上层是该槽降级的 tick（下层各位全为 0）。
+   * 每层用 64 位掩码记录非空槽，从当前位置之后的下一个槽开始找第一个置位，取各层中最早的一个。
+   * 取消定时不清除掩码，空槽被访问到时才清除，每次取消最多多处理一次空槽
+   */
+  uint64_t nextEvent() const {
+	  auto next = UINT64_MAX;
+	  for (int level = 0; level < kLevels; ++level) {
+		  auto mask = occupied_[level];
+		  if (mask == 0) {
+			  continue;
+		  }
+		  auto shift = kSlotBits * level;
+		  auto start = (now_ >> shift) + 1;
+		  auto offset = start & kSlotMask;
+		  // 旋转掩码，使 start 对应的槽位于第 0 位
+		  auto rotated = offset ? (mask >> offset) | (mask << (kSlots - offset)) : mask;
+		  auto tick = (start + __builtin_ctzll(rotated)) << shift;
+		  next = std::min(next, tick);
+	  }
+	  return next;
+  }
+
+  void place(Node *node) {
+	  auto expireAt = node->expireAt_;
+	  auto delta = expireAt - now_;
+	  // 超出最高层范围时先放在最高层最远的位置，降级时会按真实过期时间重新放置
+	  if (delta >= kMaxSpan) {
+		  expireAt = now_ + kMaxSpan - 1;
+		  delta = kMaxSpan - 1;
+	  }
+	  int level = 0;
+	  while (level < kLevels - 1 && delta >= (uint64_t(1) << (kSlotBits * (level + 1)))) {
+		  ++level;
+	  }
+	  auto index = indexOf(expireAt, level);
+	  link(wheel_[level][index], node);
+	  occupied_[level] |= uint64_t(1) << index;
+  }
+
+  static void link(TimerHook &slot, TimerHook *hook) {
+	  hook->timerNext_ = &slot;
+	  hook->timerPrev_ = slot.timerPrev_;
+	  slot.timerPrev_->timerNext_ = hook;
+	  slot.timerPrev_ = hook;
+  }
+
+  void cascade(int level, uint64_t index) {
+	  auto &slot = wheel_[level][index];
+	  // 先整体摘下再逐个放回，放回的位置一定在更低层或同层的其它槽
+	  TimerHook pending;
+	  if (slot.timerNext_ == &slot) {
+		  occupied_[level] &= ~(uint64_t(1) << index);
+		  return;
+	  }
+	  pending.timerNext_ = slot.timerNext_;
+	  pending.timerPrev_ = slot.timerPrev_;
+	  pending.timerNext_->timerPrev_ = &pending;
+	  pending.timerPrev_->timerNext_ = &pending;
+	  slot.timerPrev_ = &slot;
+	  slot.timerNext_ = &slot;
+	  occupied_[level] &= ~(uint64_t(1) << index);
+	  while (pending.timerNext_ != &pending) {
+		  auto hook = pending.timerNext_;
+		  hook->unlink();
+		  place(static_cast<Node *>(hook));
+	  }
+  }
+
+  template<typename F>
+  void expireSlot(int level, uint64_t index, F &onExpire) {
+	  auto &slot = wheel_[level][index];
+	  // 重新放置的定时器一定落在其它槽，可以先清除掩码
+	  occupied_[level] &= ~(uint64_t(1) << index);
+	  while (slot.timerNext_ != &slot) {
+		  auto hook = slot.timerNext_;
+		  hook->unlink();
+		  --size_;
+		  if (hook->expireAt_ <= now_) {
+			  onExpire(static_cast<Node *>(hook));
+		  } else {
+			  // 超出范围被截断的定时器，还没有到期，重新放置
+			  ++size_;
+			  place(static_cast<Node *>(hook));
+		  }
+	  }
+  }
+
+ private:
+  std::chrono::milliseconds resolution_;    // 每个 tick 的时长
+  uint64_t now_;                            // 已推进到的 tick
+  size_t size_;                            // 挂在时间轮上的定时器数
+  uint32_t samples_;                        // sample() 的调用次数
+  std::array<std::array<TimerHook, kSlots>, kLevels> wheel_;    // 每个槽是一个侵入式双向循环链表
+  std::array<uint64_t, kLevels> occupied_{};                    // 每层非空槽的掩码，可能包含已取消而变空的槽
+
+ public:
+// 删除拷贝语义
+  TimingWheel(const TimingWheel &other) = delete;
+  TimingWheel &operator=(const TimingWheel &other) = delete;
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_TIMINGWHEEL_H_
@@ -0,0 +1,169 @@
+/**
+  ******************************************************************************
+  * @file           : TinyLFU.h
+  * @author         : xy
+  * @brief          : W-TinyLFU 缓存：窗口 LRU + 分段 LRU 主区，由频次 sketch 决定准入
+  * @attention      : 不加锁；节点预分配在连续数组中，命中与淘汰都不分配内存
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_TINYLFU_H_
+#define CACHE_SRC_CACHE_TINYLFU_H_
+
+#include <algorithm>
+#include <cstdint>
+
+#include "CachePolicy.h"
+#include "FlatMap.h"
+#include "FrequencySketch.h"
+#include "IndexList.h"
+
+namespace Cache {
+
+/**
+ * @brief 新条目先进入占容量 1% 的窗口 LRU，从窗口淘汰出来的候选者要与主区的淘汰者比较 sketch 估算的频次，
+ * 更频繁才能进入主区，否则直接丢弃，因此一次性扫描的 key 不会冲掉主区的热点。
+ * 主区为分段 LRU：新进入的条目在试用段，再次命中后晋升到保护段（占主区 80%），保护段满时尾部降回试用段。
+ * 所有 get 与 put 都计入 sketch，包括未命中和被拒绝的 key
+ * @tparam Key
+ * @tparam Value
+ */
+template<typename Key, typename Value>
+class TinyLFU : public CachePolicy<Key, Value> {
+ public:
+  using Index = uint32_t;
+  using NodeMap = FlatMap<Key, Index>;
+  static constexpr Index kNil = UINT32_MAX;
+
+  explicit TinyLFU(size_t capacity)
+	  : capacity_(capacity), size_(0), pool_(capacity), sketch_(capacity) {
+	  windowCapacity_ = std::max<size_t>(1, capacity_ / 100);
+	  mainCapacity_ = capacity_ > windowCapacity_ ? capacity_ - windowCapacity_ : 0;
+	  protectedCapacity_ = mainCapacity_ * 8 / 10;
+	  nodeMap_.reserve(capacity_);
+  }
+
+  ~TinyLFU() = default;
+
+  void put(Key key, Value value) override {
+	  if (capacity_ <= 0) {
+		  return;
+	  }
+
+	  sketch_.increment(key);
+	  // 如果存在，更新节点值，按一次命中处理
+	  auto it = nodeMap_.find(key);
+	  if (it != nodeMap_.end()) {
+		  pool_[it->second].value_ = std::move(value);
+		  onHit(it->second);
+		  return;
+	  }
+	  // 已满时淘汰窗口候选者与主区淘汰者中频次低的一个，复用它的节点
+	  Index index = size_ < capacity_ ? static_cast<Index>(size_++) : evict();
+	  // 窗口已满而主区还有空间，窗口尾部直接进入主区
+	  if (pool_.count(kWindow) >= windowCapacity_ && mainSize() < mainCapacity_) {
+		  pool_.move(pool_.tail(kWindow), kProbation);
+	  }
+	  auto &node = pool_[index];
+	  node.key_ = key;
+	  node.value_ = std::move(value);
+	  nodeMap_.emplace(std::move(key), index);
+	  pool_.link(index, kWindow);
+  }
+
+  std::optional<Value> get(const Key &key) override {
+	  sketch_.increment(key);
+	  auto it = nodeMap_.find(key);
+	  if (it == nodeMap_.end()) {
+		  return std::nullopt;
+	  }
+	  onHit(it->second);
+	  return pool_[it->second].value_;
+  }
+
+  size_t size() const { return size_; }
+
+  size_t capacity() const { return capacity_; }
+
+  // 每个条目在 sketch 中平均占用的字节数
+  double sketchBytesPerEntry() const { return capacity_ ? double(sketch_.memoryUsage()) / capacity_ : 0; }
+
+ private:
+  // 三个区域各是节点池中的一条链表
+  enum Region : uint8_t {
+	kWindow = 0,
+	kProbation = 1,
+	kProtected = 2,
+	kRegions = 3
+  };
+
+  struct PoolNode {
+	  Key key_;
+	  Value value_;
+	  Index prev_ = 0;
+	  Index next_ = 0;
+	  Region list_ = kWindow;
+  };
+
+  size_t mainSize() const { return pool_.count(kProbation) + pool_.count(kProtected); }
+
+  void onHit(Index index) {
+	  switch (pool_[index].list_) {
+		  case kWindow:
+		  case kProtected:
+			  pool_.move(index, pool_[index].list_);
+			  break;
+		  case kProbation:
+			  // 试用段再次命中，晋升到保护段，保护段超出容量时尾部降回试用段
+			  pool_.move(index, kProtected);
+			  if (pool_.count(kProtected) > protectedCapacity_) {
+				  pool_.move(pool_.tail(kProtected), kProbation);
+			  }
+			  break;
+		  default:
+			  break;
+	  }
+  }
+
+  // 缓存已满时腾出一个节点：窗口尾部是候选者，主区试用段尾部（为空时取保护段尾部）是淘汰者
+  Index evict() {
+	  Index candidate = pool_.count(kWindow) ? pool_.tail(kWindow) : kNil;
+	  Index victim = pool_.count(kProbation) ? pool_.tail(kProbation)
+											 : pool_.count(kProtected) ? pool_.tail(kProtected) : kNil;
+	  Index evicted;
+	  if (victim == kNil) {
+		  evicted = candidate;
+	  } else if (candidate == kNil) {
+		  evicted = victim;
+	  } else if (sketch_.frequency(pool_[candidate].key_) > sketch_.frequency(pool_[victim].key_)) {
+		  // 候选者更频繁，进入主区，淘汰主区的条目
+		  pool_.move(candidate, kProbation);
+		  evicted = victim;
+	  } else {
+		  evicted = candidate;
+	  }
+	  pool_.unlink(evicted);
+	  nodeMap_.erase(pool_[evicted].key_);
+	  return evicted;
+  }
+
+ private:
+  size_t capacity_;                    // 缓存容量
+  size_t windowCapacity_;            // 窗口 LRU 容量
+  size_t mainCapacity_;                // 主区容量
+  size_t protectedCapacity_;        // 主区中保护段容量
+  size_t size_;                        // 已使用的节点数
+  IndexList<PoolNode, Region, kRegions> pool_;    // 节点池，三个区域的链表与各区域条目数
+  NodeMap nodeMap_;                    // key 到节点下标
+  FrequencySketch<Key> sketch_;        // 近期访问频次
+
+ public:
+// 删除拷贝语义
+  TinyLFU(const TinyLFU &other) = delete;
+  TinyLFU &operator=(const TinyLFU &other) = delete;
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_TINYLFU_H_
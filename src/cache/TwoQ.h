@@ -0,0 +1,136 @@
+/**
+  ******************************************************************************
+  * @file           : TwoQ.h
+  * @author         : xy
+  * @brief          : 2Q 淘汰策略：A1in FIFO + A1out 幽灵队列 + Am LRU
+  * @attention      : 不加锁；节点预分配在连续数组中，命中与淘汰都不分配内存
+  * @date           : 2026/10/16
+  ******************************************************************************
+  */
+
+#ifndef CACHE_SRC_CACHE_TWOQ_H_
+#define CACHE_SRC_CACHE_TWOQ_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+#include "CachePolicy.h"
+#include "FlatMap.h"
+#include "GhostQueue.h"
+#include "IndexList.h"
+
+namespace Cache {
+
+/**
+ * @brief 完整版 2Q。第一次出现的 key 进入 FIFO 队列 A1in（默认占容量 25%），在 A1in 中命中不改变位置；
+ * A1in 超出容量时尾部被淘汰，key 记入只保存 key 的幽灵队列 A1out（默认可记录容量 50% 个 key）。
+ * 写入的 key 在 A1out 中，说明它的重用距离超过了 A1in，才进入 LRU 队列 Am。
+ * 一次性扫描的 key 只会流过 A1in 和 A1out，Am 中的热点不受影响
+ * @tparam Key
+ * @tparam Value
+ */
+template<typename Key, typename Value>
+class TwoQ : public CachePolicy<Key, Value> {
+  using Index = uint32_t;
+  using NodeMap = FlatMap<Key, Index>;
+ public:
+  explicit TwoQ(size_t capacity, double inRatio = 0.25, double outRatio = 0.5)
+	  : capacity_(capacity), size_(0), pool_(capacity),
+		ghost_(std::max<size_t>(static_cast<size_t>(capacity * outRatio), 1)) {
+	  assert(inRatio > 0 && inRatio <= 1);
+	  inCapacity_ = std::max<size_t>(static_cast<size_t>(capacity_ * inRatio), 1);
+	  nodeMap_.reserve(capacity_);
+  }
+
+  ~TwoQ() = default;
+
+  void put(Key key, Value value) override {
+	  if (capacity_ <= 0) {
+		  return;
+	  }
+
+	  // 如果存在，更新节点值，按一次命中处理
+	  auto it = nodeMap_.find(key);
+	  if (it != nodeMap_.end()) {
+		  pool_[it->second].value_ = std::move(value);
+		  onHit(it->second);
+		  return;
+	  }
+
+	  auto queue = ghost_.take(key) ? kAm : kA1in;
+	  Index index = size_ < capacity_ ? static_cast<Index>(size_++) : evict();
+	  auto &node = pool_[index];
+	  node.key_ = key;
+	  node.value_ = std::move(value);
+	  nodeMap_.emplace(std::move(key), index);
+	  pool_.link(index, queue);
+  }
+
+  std::optional<Value> get(const Key &key) override {
+	  auto it = nodeMap_.find(key);
+	  if (it == nodeMap_.end()) {
+		  return std::nullopt;
+	  }
+	  onHit(it->second);
+	  return pool_[it->second].value_;
+  }
+
+  size_t size() const { return size_; }
+
+  size_t capacity() const { return capacity_; }
+
+ private:
+  // 两个队列各是节点池中的一条链表
+  enum Queue : uint8_t {
+	kA1in = 0,
+	kAm = 1,
+	kQueues = 2
+  };
+
+  struct PoolNode {
+	  Key key_;
+	  Value value_;
+	  Index prev_ = 0;
+	  Index next_ = 0;
+	  Queue list_ = kA1in;
+  };
+
+  // A1in 是 FIFO，命中不移动；Am 是 LRU，命中移到头部
+  void onHit(Index index) {
+	  if (pool_[index].list_ == kAm) {
+		  pool_.move(index, kAm);
+	  }
+  }
+
+  // 缓存已满时腾出一个节点：A1in 超出容量或 Am 为空时淘汰 A1in 尾部并记入 A1out，否则淘汰 Am 尾部
+  Index evict() {
+	  Index evicted;
+	  if (pool_.count(kA1in) >= inCapacity_ || pool_.count(kAm) == 0) {
+		  evicted = pool_.tail(kA1in);
+		  ghost_.push(pool_[evicted].key_);
+	  } else {
+		  evicted = pool_.tail(kAm);
+	  }
+	  pool_.unlink(evicted);
+	  nodeMap_.erase(pool_[evicted].key_);
+	  return evicted;
+  }
+
+ private:
+  size_t capacity_;                    // 缓存容量
+  size_t inCapacity_;                // A1in 容量
+  size_t size_;                        // 已使用的节点数
+  IndexList<PoolNode, Queue, kQueues> pool_;    // 节点池，两个队列的链表与各队列条目数
+  NodeMap nodeMap_;                    // key 到节点下标
+  GhostQueue<Key> ghost_;            // A1out，只保存 key
+
+ public:
+// 删除拷贝语义
+  TwoQ(const TwoQ &other) = delete;
+  TwoQ &operator=(const TwoQ &other) = delete;
+};
+
+}
+
+#endif //CACHE_SRC_CACHE_TWOQ_H_
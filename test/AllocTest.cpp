@@ -0,0 +1,119 @@
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include "LRU.h"
+#include "LFU.h"
+#include "PoolLRU.h"
+#include "MPSCQueue.h"
+#include "InlineTask.h"
+
+using namespace Cache;
+
+// 统计全局 operator new 的调用次数
+static size_t allocCount = 0;
+
+void *operator new(size_t size) {
+	++allocCount;
+	if (void *ptr = std::malloc(size)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+// 超过短字符串优化长度的 key，构造 std::string 必然分配内存
+std::string makeKey(int i) {
+	return "a-key-that-is-long-enough-to-allocate-" + std::to_string(i);
+}
+
+// 命中路径不分配内存：const std::string &、std::string_view、const char * 三种查找方式
+template<typename Cache>
+void testHitPath(const std::string &name, Cache &cache) {
+	for (int i = 0; i < 100; ++i) {
+		cache.put(makeKey(i), i);
+	}
+	std::string key = makeKey(42);
+	std::string_view view = key;
+	const char *cstr = key.c_str();
+
+	auto before = allocCount;
+	auto byRef = cache.get(key);
+	auto byView = cache.get(view);
+	auto byCStr = cache.get(cstr);
+	auto hitAllocs = allocCount - before;
+
+	assert(byRef != std::nullopt && byRef.value() == 42);
+	assert(byView != std::nullopt && byView.value() == 42);
+	assert(byCStr != std::nullopt && byCStr.value() == 42);
+	assert(hitAllocs == 0);
+
+	// 更新已有 key 时，右值 key 一路移动进去，不会再拷贝
+	std::string moved = makeKey(7);
+	before = allocCount;
+	cache.put(std::move(moved), 700);
+	auto putAllocs = allocCount - before;
+	assert(putAllocs == 0);
+	assert(cache.get(makeKey(7)).value() == 700);
+
+	std::cout << name << " 命中路径分配次数: " << hitAllocs << " | 更新路径分配次数: " << putAllocs << std::endl;
+}
+
+// 工作线程任务队列：与 LRUCache::put 捕获相同的任务直接放在槽位中，投递与取出都不分配内存；
+// 超出内联容量的任务退回堆上分配一次，仍能正常执行
+void testTaskQueue() {
+	MPSCQueue<InlineTask> tasks(16);
+	InlineTask task;
+	int sum = 0;
+	std::string key = "key", value = "value";
+	uint64_t version = 7;
+
+	auto before = allocCount;
+	for (int i = 0; i < 100; ++i) {
+		bool pushed = tasks.tryPush([&sum, i, key, value, version]() mutable {
+		  sum += i + static_cast<int>(key.size() + value.size() + version);
+		});
+		assert(pushed && tasks.tryPop(task));
+		task();
+	}
+	task = nullptr;
+	auto inlineAllocs = allocCount - before;
+	assert(inlineAllocs == 0);
+	assert(sum == 100 * 99 / 2 + 100 * 15);
+
+	char large[InlineTask::kCapacity] = {1};
+	before = allocCount;
+	bool pushed = tasks.tryPush([&sum, large]() { sum += large[0]; });
+	assert(pushed && tasks.tryPop(task));
+	task();
+	auto heapAllocs = allocCount - before;
+	assert(heapAllocs == 1);
+	std::cout << "任务队列 内联任务分配次数: " << inlineAllocs << " | 超出内联容量的任务分配次数: " << heapAllocs << std::endl;
+}
+
+int main() {
+	LRU<std::string, int> lru(1000);
+	testHitPath("LRU", lru);
+
+	PoolLRU<std::string, int> poolLru(1000);
+	testHitPath("PoolLRU", poolLru);
+
+	// LFU 命中会在频率链表之间迁移节点，可能新建频率链表，这里只验证异构查找
+	LFU<std::string, int> lfu(1000);
+	lfu.put(makeKey(1), 1);
+	assert(lfu.get(std::string_view(makeKey(1))).value() == 1);
+	assert(lfu.get("missing") == std::nullopt);
+
+	testTaskQueue();
+
+	return 0;
+}
@@ -1,25 +1,42 @@
 #include <iostream>
+#include <cassert>
+#include <unordered_map>
 #include <vector>
 #include <random>
 #include <chrono>
 #include "LRU.h"
 #include "LFU.h"
 #include "ArcCache.h"
+#include "ClockLRU.h"
+#include "TinyLFU.h"
+#include "Sieve.h"
+#include "S3FIFO.h"
+#include "SLRU.h"
+#include "TwoQ.h"
+#include "LIRS.h"
+#include "LRUCache.h"
+#include "LFUCache.h"
 
 using namespace std;
 using namespace Cache;
 
-// 统一缓存初始化
-std::vector<CachePolicy < int, std::string> *>
-
-initializeCaches(int capacity) {
-	return {new LRU<int, std::string>(capacity),
-			new LFU<int, std::string>(capacity),
-			new ArcCache<int, std::string>(capacity, 2)};
+// 统一缓存初始化，名字用于区分输出
+std::vector<std::pair<std::string, CachePolicy<int, std::string> *>> initializeCaches(int capacity) {
+	return {{"LRU", new LRU<int, std::string>(capacity)},
+			{"LFU", new LFU<int, std::string>(capacity)},
+			{"ARC", new ArcCache<int, std::string>(capacity, 2)},
+			{"CLOCK", new ClockLRU<int, std::string>(capacity)},
+			{"TinyLFU", new TinyLFU<int, std::string>(capacity)},
+			{"LRU-2", new KLru<int, std::string>(capacity, 2)},
+			{"SIEVE", new Sieve<int, std::string>(capacity)},
+			{"S3-FIFO", new S3FIFO<int, std::string>(capacity)},
+			{"SLRU", new SLRU<int, std::string>(capacity)},
+			{"2Q", new TwoQ<int, std::string>(capacity)},
+			{"LIRS", new LIRS<int, std::string>(capacity)}};
 }
 
 // 统一缓存测试逻辑
-void performCacheOperations(CachePolicy<int, std::string> *cache, int operations, int hotDataNum, int coldDataNum) {
+void performCacheOperations(const std::string &name, CachePolicy<int, std::string> *cache, int operations, int hotDataNum, int coldDataNum) {
 	std::random_device rd;
 	std::mt19937 gen(rd());
 	int hits = 0, get_ops = 0;
@@ -40,7 +57,7 @@ void performCacheOperations(CachePolicy<int, std::string> *cache, int operations
 	auto end_time = std::chrono::high_resolution_clock::now();
 	std::chrono::duration<double> elapsed = end_time - start_time;
 
-	std::cout << "命中率: " << (100.0 * hits / get_ops) << "%";
+	std::cout << name << "\t命中率: " << (100.0 * hits / get_ops) << "%";
 	std::cout << " | 访问耗时: " << elapsed.count() << " 秒" << std::endl;
 }
 
@@ -48,8 +65,8 @@ void performCacheOperations(CachePolicy<int, std::string> *cache, int operations
 void testHotDataAccess(int capacity, int hotDataNum, int coldDataNum, int operations) {
 	std::cout << "\n=== 测试场景1：热点数据访问测试 ===\n";
 	auto caches = initializeCaches(capacity);
-	for (auto &cache : caches) {
-		performCacheOperations(cache, operations, hotDataNum, coldDataNum);
+	for (auto &[name, cache] : caches) {
+		performCacheOperations(name, cache, operations, hotDataNum, coldDataNum);
 		delete cache;
 	}
 }
@@ -61,7 +78,7 @@ void testLoopPattern(int capacity, int loopSize, int operations) {
 	std::random_device rd;
 	std::mt19937 gen(rd());
 
-	for (auto &cache : caches) {
+	for (auto &[name, cache] : caches) {
 		for (int key = 0; key < loopSize; ++key) {
 			cache->put(key, "loop" + std::to_string(key));
 		}
@@ -74,7 +91,7 @@ void testLoopPattern(int capacity, int loopSize, int operations) {
 				hits++;
 			}
 		}
-		std::cout << "命中率: " << (100.0 * hits / get_ops) << "%" << std::endl;
+		std::cout << name << "\t命中率: " << (100.0 * hits / get_ops) << "%" << std::endl;
 		delete cache;
 	}
 }
@@ -87,7 +104,7 @@ void testWorkloadShift(int capacity, int operations) {
 	std::mt19937 gen(rd());
 	int phase_length = operations / 5;
 
-	for (auto &cache : caches) {
+	for (auto &[name, cache] : caches) {
 		for (int key = 0; key < 1000; ++key) {
 			cache->put(key, "init" + std::to_string(key));
 		}
@@ -107,34 +124,183 @@ void testWorkloadShift(int capacity, int operations) {
 				cache->put(key, "new" + std::to_string(key));
 			}
 		}
-		std::cout << "命中率: " << (100.0 * hits / get_ops) << "%" << std::endl;
+		std::cout << name << "\t命中率: " << (100.0 * hits / get_ops) << "%" << std::endl;
+		delete cache;
+	}
+}
+
+// 扫描干扰测试：热点访问中夹杂大量只出现一次的 key，未命中时写入
+void testScanResistance(int capacity, int hotDataNum, int operations) {
+	std::cout << "\n=== 测试场景4：扫描干扰测试 ===\n";
+	auto caches = initializeCaches(capacity);
+	std::random_device rd;
+	std::mt19937 gen(rd());
+
+	for (auto &[name, cache] : caches) {
+		int hits = 0, hot_ops = 0, scan_key = hotDataNum;
+		for (int op = 0; op < operations; ++op) {
+			bool hot = gen() % 100 < 50;
+			int key = hot ? gen() % hotDataNum : scan_key++;
+			if (cache->get(key) != std::nullopt) {
+				hits++;
+			} else {
+				cache->put(key, "value" + std::to_string(key));
+			}
+			hot_ops += hot;
+		}
+		std::cout << name << "\t热点命中率: " << (100.0 * hits / hot_ops) << "%" << std::endl;
 		delete cache;
 	}
 }
 
+// 循环回填测试：按顺序循环访问略大于容量的 key，未命中时写入，重用距离都超过容量
+void testLoopRefill(int capacity, int loopSize, int operations) {
+	std::cout << "\n=== 测试场景5：循环回填测试 ===\n";
+	auto caches = initializeCaches(capacity);
+
+	for (auto &[name, cache] : caches) {
+		int hits = 0;
+		for (int op = 0; op < operations; ++op) {
+			int key = op % loopSize;
+			if (cache->get(key) != std::nullopt) {
+				hits++;
+			} else {
+				cache->put(key, "loop" + std::to_string(key));
+			}
+		}
+		std::cout << name << "\t命中率: " << (100.0 * hits / operations) << "%" << std::endl;
+		delete cache;
+	}
+}
+
+// 极小容量测试：容量为 1、2 时随机读写，命中的值必须是该 key 最后一次写入的值
+void testTinyCapacity(int operations) {
+	std::cout << "\n=== 测试场景6：极小容量测试 ===\n";
+	std::mt19937 gen(42);
+	for (int capacity : {1, 2}) {
+		auto caches = initializeCaches(capacity);
+		for (auto &[name, cache] : caches) {
+			std::unordered_map<int, std::string> latest;
+			int hits = 0;
+			for (int op = 0; op < operations; ++op) {
+				int key = gen() % 4;
+				if (gen() % 2) {
+					latest[key] = "value" + std::to_string(op);
+					cache->put(key, latest[key]);
+				} else if (auto value = cache->get(key)) {
+					assert(*value == latest[key]);
+					hits++;
+				}
+			}
+			std::cout << name << "\t容量 " << capacity << " 命中次数: " << hits << std::endl;
+			delete cache;
+		}
+	}
+}
+
+// LRU-K 历史记录只有一条时，重新写入的 key 必须带回它的 K 次访问时间，不能被淘汰时挤进历史的条目顶掉
+void testKLruHistory() {
+	std::cout << "\n=== 测试场景7：LRU-K 历史记录测试 ===\n";
+	KLru<int, std::string> cache(2, 2, 1);
+	cache.put(1, "one");
+	cache.put(2, "two");
+	cache.get(2);
+	cache.get(1);
+	// 1 的第 2 近访问更早，先被淘汰进历史
+	cache.put(3, "three");
+	// 淘汰只访问过一次的 3，3 进入历史时 1 的历史已经取出
+	cache.put(1, "one");
+	// 1 带回了历史，第 2 近访问晚于 2，这次淘汰 2
+	cache.put(4, "four");
+	assert(cache.get(1) == "one");
+	assert(!cache.get(2));
+	std::cout << "LRU-2\t重新写入的 key 保留了历史访问时间" << std::endl;
+}
+
+// 多线程缓存在两种路由方式下的命中率：调用方不指定线程，轮询时 put 与 get 常落在不同线程
+template<typename CacheType>
+void performRouteOperations(const std::string &name, int capacity, int threadNum, int operations, int hotDataNum, int coldDataNum, int loopSize) {
+	std::random_device rd;
+	std::mt19937 gen(rd());
+	for (auto mode : {RouteMode::RoundRobin, RouteMode::HashAffinity}) {
+		CacheType cache(capacity, threadNum, 3600, mode);
+		int hits = 0;
+		for (int op = 0; op < operations; ++op) {
+			int key = (op % 100 < 70) ? gen() % hotDataNum : hotDataNum + (gen() % coldDataNum);
+			cache.put(key, "value" + std::to_string(key));
+		}
+		for (int op = 0; op < operations; ++op) {
+			int key = (op % 100 < 70) ? gen() % hotDataNum : hotDataNum + (gen() % coldDataNum);
+			if (cache.get(key) != std::nullopt) {
+				hits++;
+			}
+		}
+
+		CacheType loopCache(capacity, threadNum, 3600, mode);
+		for (int key = 0; key < loopSize; ++key) {
+			loopCache.put(key, "loop" + std::to_string(key));
+		}
+		int loopHits = 0, current_pos = 0;
+		for (int op = 0; op < operations; ++op) {
+			int key = (op % 100 < 60) ? current_pos : (gen() % loopSize);
+			current_pos = (current_pos + 1) % loopSize;
+			if (loopCache.get(key) != std::nullopt) {
+				loopHits++;
+			}
+		}
+
+		std::cout << name << (mode == RouteMode::RoundRobin ? " 轮询" : " 哈希");
+		std::cout << "\t热点命中率: " << (100.0 * hits / operations) << "%";
+		std::cout << " | 循环命中率: " << (100.0 * loopHits / operations) << "%" << std::endl;
+	}
+}
+
+// 路由方式对比测试
+void testRouteMode(int capacity, int threadNum, int operations, int hotDataNum, int coldDataNum, int loopSize) {
+	std::cout << "\n=== 路由方式测试：每线程容量 " << capacity << "，" << threadNum << " 个线程 ===\n";
+	performRouteOperations<LRUCache<int, std::string>>("LRUCache", capacity, threadNum, operations, hotDataNum, coldDataNum, loopSize);
+	performRouteOperations<LFUCache<int, std::string>>("LFUCache", capacity, threadNum, operations, hotDataNum, coldDataNum, loopSize);
+}
+
 int main() {
 	std::cout << "=== 缓存测试 1 ===" << std::endl;
 	std::cout << "capacity " << 100 << " operations " << 10000 << std::endl;
 	testHotDataAccess(100, 50, 500, 10000);
 	testLoopPattern(100, 200, 10000);
 	testWorkloadShift(100, 10000);
+	testScanResistance(100, 80, 10000);
+	testLoopRefill(100, 150, 10000);
 
 	std::cout << "\n=== 缓存测试 2 ===" << std::endl;
 	std::cout << "capacity " << 200 << " operations " << 20000 << std::endl;
 	testHotDataAccess(200, 100, 1000, 20000);
 	testLoopPattern(300, 500, 20000);
 	testWorkloadShift(300, 30000);
+	testScanResistance(200, 160, 20000);
+	testLoopRefill(300, 450, 20000);
 
 	std::cout << "\n=== 缓存测试 3 ===" << std::endl;
 	std::cout << "capacity " << 500 << " operations " << 50000 << std::endl;
 	testHotDataAccess(500, 200, 2000, 50000);
 	testLoopPattern(500, 1000, 50000);
 	testWorkloadShift(500, 50000);
+	testScanResistance(500, 400, 50000);
+	testLoopRefill(500, 750, 50000);
 
 	std::cout << "\n=== 缓存测试 4 ===" << std::endl;
 	std::cout << "capacity " << 8000 << " operations " << 500000 << std::endl;
 	testHotDataAccess(8000, 2000, 20000, 500000);
 	testLoopPattern(8000, 1000, 500000);
 	testWorkloadShift(8000, 500000);
+	testScanResistance(8000, 6400, 500000);
+	testLoopRefill(8000, 12000, 500000);
+
+	testTinyCapacity(10000);
+	testKLruHistory();
+
+	std::cout << "\n=== 多线程缓存路由 ===" << std::endl;
+	testRouteMode(100, 4, 10000, 50, 500, 200);
+	testRouteMode(200, 4, 20000, 100, 1000, 500);
+	testRouteMode(500, 4, 50000, 200, 2000, 1000);
 	return 0;
 }
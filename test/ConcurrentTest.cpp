@@ -0,0 +1,592 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <algorithm>
+#include "ShardedCache.h"
+#include "ShardedArcCache.h"
+#include "LFU.h"
+#include "Sieve.h"
+#include "S3FIFO.h"
+#include "LRUCache.h"
+#include "LFUCache.h"
+
+using namespace std;
+using namespace Cache;
+
+// 多个线程同时读写同一个缓存，返回吞吐量（百万次操作每秒）
+// scanPercent 为只出现一次的扫描 key 所占的百分比，其余 key 在 [0, keyRange) 中均匀分布
+double runConcurrent(CachePolicy<int, int> *cache, int threadNum, int opsPerThread, int keyRange, int scanPercent = 0) {
+	std::atomic<long> hits{0};
+	std::vector<std::thread> workers;
+
+	auto start_time = std::chrono::high_resolution_clock::now();
+	for (int t = 0; t < threadNum; ++t) {
+		workers.emplace_back([cache, t, opsPerThread, keyRange, scanPercent, &hits]() {
+			std::mt19937 gen(t);
+			long localHits = 0;
+			for (int op = 0; op < opsPerThread; ++op) {
+				int key = static_cast<int>(gen() % 100) < scanPercent ? keyRange + t * opsPerThread + op : gen() % keyRange;
+				if (cache->get(key) != std::nullopt) {
+					localHits++;
+				} else {
+					cache->put(key, key);
+				}
+			}
+			hits += localHits;
+		});
+	}
+	for (auto &worker : workers) {
+		worker.join();
+	}
+	auto end_time = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<double> elapsed = end_time - start_time;
+
+	auto totalOps = static_cast<double>(threadNum) * opsPerThread;
+	std::cout << "命中率: " << (100.0 * hits / totalOps) << "%";
+	std::cout << " | 吞吐量: " << totalOps / elapsed.count() / 1e6 << " Mops/s" << std::endl;
+	return totalOps / elapsed.count();
+}
+
+// 单锁 LRU 与分片 LRU 的多线程吞吐对比
+void testShardedLRU(int capacity, int threadNum, int opsPerThread) {
+	std::cout << "\n=== 单锁 LRU vs 分片 LRU ===\n";
+	std::cout << "capacity " << capacity << " threads " << threadNum << std::endl;
+
+	auto single = new ShardedCache<int, int, PoolLRU<int, int>>(capacity, 1);
+	std::cout << "单锁 ";
+	runConcurrent(single, threadNum, opsPerThread, capacity * 2);
+	delete single;
+
+	auto sharded = new ShardedLRU<int, int>(capacity, 64);
+	std::cout << "分片 ";
+	runConcurrent(sharded, threadNum, opsPerThread, capacity * 2);
+	delete sharded;
+}
+
+// 单锁 ARC 与分片 ARC 的多线程吞吐与命中率对比：热点 key 与只出现一次的扫描 key 混合
+void testShardedArc(int capacity, int threadNum, int opsPerThread) {
+	std::cout << "\n=== 单锁 ARC vs 分片 ARC ===\n";
+	std::cout << "capacity " << capacity << " threads " << threadNum << std::endl;
+
+	auto single = new ShardedArcCache<int, int>(capacity, 1, 2);
+	std::cout << "单锁 ";
+	runConcurrent(single, threadNum, opsPerThread, capacity / 2, 30);
+	delete single;
+
+	auto sharded = new ShardedArcCache<int, int>(capacity, 64, 2);
+	std::cout << "分片 ";
+	runConcurrent(sharded, threadNum, opsPerThread, capacity / 2, 30);
+	delete sharded;
+
+	auto lru = new ShardedLRU<int, int>(capacity, 64);
+	std::cout << "分片 LRU ";
+	runConcurrent(lru, threadNum, opsPerThread, capacity / 2, 30);
+	delete lru;
+}
+
+// 命中只改原子计数的 SIEVE、S3-FIFO 与单锁包装的 LRU、LFU、ARC 的多线程吞吐对比，
+// 工作集与容量相同，另有 5% 只出现一次的扫描 key
+void testFifoThroughput(int capacity, int threadNum, int opsPerThread) {
+	std::cout << "\n=== 单锁 LRU/LFU/ARC vs SIEVE/S3-FIFO ===\n";
+	std::cout << "capacity " << capacity << " threads " << threadNum << std::endl;
+
+	std::vector<std::pair<std::string, CachePolicy<int, int> *>> caches = {
+		{"LRU     ", new ShardedCache<int, int, LRU<int, int>>(capacity, 1)},
+		{"LFU     ", new ShardedCache<int, int, LFU<int, int>>(capacity, 1)},
+		{"ARC     ", new ShardedArcCache<int, int>(capacity, 1, 2)},
+		{"SIEVE   ", new Sieve<int, int>(capacity)},
+		{"S3-FIFO ", new S3FIFO<int, int>(capacity)}};
+	for (auto &[name, cache] : caches) {
+		std::cout << name;
+		runConcurrent(cache, threadNum, opsPerThread, capacity, 5);
+		delete cache;
+	}
+}
+
+// 不加锁的读与写并发：写线程不断更新、淘汰，读线程读到的值必须是某次完整写入的值，
+// 被替换或淘汰的记录等读者退出后才释放
+template<typename CacheType>
+void runLockFreeRead(const std::string &name, int readerNum, int writes) {
+	CacheType cache(500);
+	auto valueOf = [](int key) { return std::string(40, static_cast<char>('a' + key % 26)) + std::to_string(key); };
+	std::atomic<bool> stop{false};
+	std::atomic<long> hits{0};
+	std::vector<std::thread> readers;
+	for (int t = 0; t < readerNum; ++t) {
+		readers.emplace_back([&cache, &stop, &hits, &valueOf, t]() {
+			std::mt19937 gen(t);
+			long localHits = 0;
+			while (!stop.load(std::memory_order_relaxed)) {
+				int key = gen() % 2000;
+				if (auto value = cache.get(key)) {
+					assert(*value == valueOf(key));
+					localHits++;
+				}
+			}
+			hits += localHits;
+		});
+	}
+	std::mt19937 gen(100);
+	for (int i = 0; i < writes; ++i) {
+		int key = gen() % 2000;
+		cache.put(key, valueOf(key));
+	}
+	stop = true;
+	for (auto &reader : readers) {
+		reader.join();
+	}
+	assert(cache.size() == 500);
+	std::cout << name << "\t" << readerNum << " 个读线程与写线程并发，命中 " << hits << " 次，值都完整" << std::endl;
+}
+
+void testLockFreeRead() {
+	std::cout << "\n=== 不加锁的读与写并发 ===\n";
+	runLockFreeRead<Sieve<int, std::string>>("SIEVE", 4, 200000);
+	runLockFreeRead<S3FIFO<int, std::string>>("S3-FIFO", 4, 200000);
+}
+
+// 逐个 get 与 multiGet 的吞吐对比，每批 batch 个 key
+template<typename CacheType>
+void runMultiGet(const std::string &name, int capacity, int batch, int rounds) {
+	CacheType cache(capacity, 4, 3600);
+	std::mt19937 gen(42);
+	std::vector<std::pair<int, int>> items;
+	for (int key = 0; key < capacity; ++key) {
+		items.emplace_back(key, key);
+	}
+	cache.multiPut(std::move(items), 0);
+
+	std::vector<int> keys(batch);
+	long hits = 0;
+	auto start_time = std::chrono::high_resolution_clock::now();
+	for (int round = 0; round < rounds; ++round) {
+		for (auto &key : keys) {
+			key = gen() % (capacity * 2);
+		}
+		for (int key : keys) {
+			if (cache.get(key, 0) != std::nullopt) {
+				hits++;
+			}
+		}
+	}
+	auto end_time = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<double> single = end_time - start_time;
+
+	long batchHits = 0;
+	start_time = std::chrono::high_resolution_clock::now();
+	for (int round = 0; round < rounds; ++round) {
+		for (auto &key : keys) {
+			key = gen() % (capacity * 2);
+		}
+		for (const auto &result : cache.multiGet(keys, 0)) {
+			if (result != std::nullopt) {
+				batchHits++;
+			}
+		}
+	}
+	end_time = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<double> multi = end_time - start_time;
+
+	auto totalKeys = static_cast<double>(batch) * rounds;
+	std::cout << name << " 逐个 get: " << totalKeys / single.count() / 1e6 << " Mkeys/s (命中 " << hits << ")";
+	std::cout << " | multiGet: " << totalKeys / multi.count() / 1e6 << " Mkeys/s (命中 " << batchHits << ")";
+	std::cout << " | 加速比: " << single.count() / multi.count() << std::endl;
+}
+
+void testMultiGet(int capacity, int batch, int rounds) {
+	std::cout << "\n=== get vs multiGet ===\n";
+	std::cout << "capacity " << capacity << " batch " << batch << std::endl;
+	runMultiGet<LRUCache<int, int>>("LRUCache", capacity, batch, rounds);
+	runMultiGet<LFUCache<int, int>>("LFUCache", capacity, batch, rounds);
+}
+
+// 阻塞 get 与 getAsync 流水线的吞吐对比：getAsync 一次发出全部请求，再等待所有回调完成
+template<typename CacheType>
+void runAsyncGet(const std::string &name, int capacity, int requests) {
+	CacheType cache(capacity, 4, 3600);
+	std::vector<std::pair<int, int>> items;
+	for (int key = 0; key < capacity; ++key) {
+		items.emplace_back(key, key);
+	}
+	cache.multiPut(std::move(items), 0);
+
+	std::mt19937 gen(42);
+	std::vector<int> keys(requests);
+	for (auto &key : keys) {
+		key = gen() % (capacity * 2);
+	}
+
+	long hits = 0;
+	auto start_time = std::chrono::high_resolution_clock::now();
+	for (int key : keys) {
+		if (cache.get(key, 0) != std::nullopt) {
+			hits++;
+		}
+	}
+	auto end_time = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<double> blocking = end_time - start_time;
+
+	std::atomic<long> done{0}, asyncHits{0};
+	start_time = std::chrono::high_resolution_clock::now();
+	for (int key : keys) {
+		cache.getAsync(key, 0, [&done, &asyncHits](std::optional<int> result) {
+		  if (result != std::nullopt) {
+			  asyncHits.fetch_add(1, std::memory_order_relaxed);
+		  }
+		  done.fetch_add(1, std::memory_order_release);
+		});
+	}
+	while (done.load(std::memory_order_acquire) < requests) {
+		std::this_thread::yield();
+	}
+	end_time = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<double> async = end_time - start_time;
+
+	std::cout << name << " 阻塞 get: " << requests / blocking.count() / 1e6 << " Mops/s (命中 " << hits << ")";
+	std::cout << " | getAsync: " << requests / async.count() / 1e6 << " Mops/s (命中 " << asyncHits << ")";
+	std::cout << " | 加速比: " << blocking.count() / async.count() << std::endl;
+}
+
+void testAsyncGet(int capacity, int requests) {
+	std::cout << "\n=== get vs getAsync ===\n";
+	std::cout << "capacity " << capacity << " requests " << requests << std::endl;
+	runAsyncGet<LRUCache<int, int>>("LRUCache", capacity, requests);
+	runAsyncGet<LFUCache<int, int>>("LFUCache", capacity, requests);
+}
+
+// getAsync 的回调中再调用本缓存：操作都落在同一个工作线程上，直接在回调中执行，
+// 不会等待只有自己能完成的 future，写入次数超过任务队列容量也不会卡住
+template<typename CacheType>
+void runReentrantCallback(const std::string &name, RouteMode mode) {
+	CacheType cache(10000, 1, 3600, mode);
+	cache.put(1, 1);
+	std::promise<int> done;
+	auto result = done.get_future();
+	cache.getAsync(1, [&cache, &done](std::optional<int> value) {
+	  assert(value == 1);
+	  for (int key = 2; key < 10000; ++key) {
+		  cache.put(key, key);
+	  }
+	  cache.put(2, 20, std::chrono::seconds(10));
+	  cache.multiPut({{3, 30}});
+	  auto values = cache.multiGet({1, 2, 3});
+	  done.set_value(*cache.get(2) + *values[2]);
+	});
+	assert(result.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+	assert(result.get() == 50);
+	std::cout << name << "\t回调中调用同一工作线程上的缓存不会卡死" << std::endl;
+}
+
+void testReentrantCallback() {
+	std::cout << "\n=== getAsync 回调重入 ===\n";
+	runReentrantCallback<LRUCache<int, int>>("LRUCache 轮询", RouteMode::RoundRobin);
+	runReentrantCallback<LRUCache<int, int>>("LRUCache 哈希", RouteMode::HashAffinity);
+	runReentrantCallback<LFUCache<int, int>>("LFUCache 轮询", RouteMode::RoundRobin);
+	runReentrantCallback<LFUCache<int, int>>("LFUCache 哈希", RouteMode::HashAffinity);
+}
+
+// 原先的工作线程收件箱：互斥锁保护的 std::queue，每次投递都 notify_one
+class MutexWorker {
+ public:
+	MutexWorker() {
+		worker_ = std::thread([this] {
+			while (!isStop_) {
+				std::unique_lock<std::mutex> lock(mutex_);
+				condition_.wait(lock, [this] { return !tasks_.empty() || isStop_; });
+				if (!tasks_.empty()) {
+					auto task = std::move(tasks_.front());
+					tasks_.pop();
+					lock.unlock();
+					task();
+				}
+			}
+		});
+	}
+
+	~MutexWorker() {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			isStop_ = true;
+		}
+		condition_.notify_one();
+		worker_.join();
+	}
+
+	void post(std::function<void()> task) {
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			tasks_.emplace(std::move(task));
+		}
+		condition_.notify_one();
+	}
+
+ private:
+	std::queue<std::function<void()>> tasks_;
+	std::mutex mutex_;
+	std::condition_variable condition_;
+	std::thread worker_;
+	bool isStop_ = false;
+};
+
+// producerNum 个线程同时向一个工作线程投递共 totalTasks 个任务，返回投递并执行完毕的吞吐量（百万任务每秒）
+template<typename Worker>
+double runPost(Worker &worker, int producerNum, int totalTasks) {
+	std::atomic<long> done{0};
+	std::vector<std::thread> producers;
+	int perProducer = totalTasks / producerNum;
+
+	auto start_time = std::chrono::high_resolution_clock::now();
+	for (int p = 0; p < producerNum; ++p) {
+		producers.emplace_back([&worker, &done, perProducer]() {
+			for (int i = 0; i < perProducer; ++i) {
+				worker.post([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+			}
+		});
+	}
+	for (auto &producer : producers) {
+		producer.join();
+	}
+	while (done.load(std::memory_order_relaxed) < static_cast<long>(perProducer) * producerNum) {
+		std::this_thread::yield();
+	}
+	auto end_time = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<double> elapsed = end_time - start_time;
+	return static_cast<double>(perProducer) * producerNum / elapsed.count() / 1e6;
+}
+
+// 工作线程任务队列随生产者数量的扩展性：互斥锁队列 vs 无锁环形队列
+void testPostScaling(int totalTasks) {
+	std::cout << "\n=== 互斥锁队列 vs 无锁环形队列 ===\n";
+	std::cout << "tasks " << totalTasks << std::endl;
+	for (int producerNum : {1, 2, 4, 8, 16, 32, 64}) {
+		MutexWorker mutexWorker;
+		LRUThread<int, int> ringWorker(16, 0);
+		auto mutexOps = runPost(mutexWorker, producerNum, totalTasks);
+		auto ringOps = runPost(ringWorker, producerNum, totalTasks);
+		std::cout << "producers " << producerNum << "\t互斥锁: " << mutexOps << " Mtasks/s";
+		std::cout << " | 无锁: " << ringOps << " Mtasks/s";
+		std::cout << " | 加速比: " << ringOps / mutexOps << std::endl;
+	}
+}
+
+// 一轮同步的耗时：先写满缓存并同步一次，再写入 writes 个 key，计时同步到所有分片应用完毕
+template<typename CacheType>
+double runSyncCost(int capacity, int threadNum, int writes) {
+	CacheType cache(capacity, threadNum, 3600);
+	std::vector<std::pair<int, int>> items;
+	for (int key = 0; key < capacity; ++key) {
+		items.emplace_back(key, key);
+	}
+	cache.multiPut(std::move(items), 0);
+	cache.get(0, 0);
+	cache.syncCache();
+
+	std::mt19937 gen(42);
+	for (int i = 0; i < writes; ++i) {
+		int key = gen() % capacity;
+		cache.put(key, -key, i % threadNum);
+	}
+	// 每个工作线程按顺序执行任务，get 返回时它之前的写入和同步任务都已完成
+	for (int i = 0; i < threadNum; ++i) {
+		cache.get(0, i);
+	}
+
+	auto start_time = std::chrono::high_resolution_clock::now();
+	cache.syncCache();
+	for (int i = 0; i < threadNum; ++i) {
+		cache.get(0, i);
+	}
+	auto end_time = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<double, std::milli> elapsed = end_time - start_time;
+	return elapsed.count();
+}
+
+// 同步开销只与两次同步之间的写入量有关，与缓存大小无关
+void testSyncCost(int threadNum) {
+	std::cout << "\n=== 增量同步耗时 ===\n";
+	std::cout << "threads " << threadNum << std::endl;
+	for (int capacity : {10000, 100000}) {
+		for (int writes : {100, 10000}) {
+			std::cout << "capacity " << capacity << " writes " << writes;
+			std::cout << "\tLRUCache: " << runSyncCost<LRUCache<int, int>>(capacity, threadNum, writes) << " ms";
+			std::cout << " | LFUCache: " << runSyncCost<LFUCache<int, int>>(capacity, threadNum, writes) << " ms" << std::endl;
+		}
+	}
+}
+
+// 脏 key 超过两倍容量时会清理已被淘汰的 key，最后一次写入的 key 仍要能同步出去
+template<typename MultiType>
+void runDrainAfterPrune(const std::string &name) {
+	MultiType cache(2);
+	for (int key = 0; key < 5; ++key) {
+		cache.put(key, key * 10, key + 1);
+	}
+	auto entries = cache.drainChanges();
+	// 容量为 2，同步出的正是缓存中的两个 key，其中一定有最后写入的 4
+	assert(entries.size() == 2);
+	bool hasLast = false;
+	for (auto &entry : entries) {
+		assert(entry.value_ == entry.key_ * 10);
+		assert(cache.get(entry.key_) != std::nullopt);
+		hasLast |= entry.key_ == 4;
+	}
+	assert(hasLast);
+	std::cout << name << "\t清理后仍同步最后写入的 key，同步条目数: " << entries.size() << std::endl;
+}
+
+void testDrainAfterPrune() {
+	std::cout << "\n=== 脏 key 清理 ===\n";
+	runDrainAfterPrune<MultiLRU<int, int>>("MultiLRU");
+	runDrainAfterPrune<MultiLFU<int, int>>("MultiLFU");
+}
+
+// 分片上一次取出并应用 writes 个脏 key 的耗时：先写满缓存并取走一次，脏 key 索引已扩到容量大小，
+// 再写入 writes 个 key；重复 rounds 次取最短的一次，排除调度抖动。每轮写同一批 key，
+// 它们的节点与索引槽位都已在 CPU 缓存中，不同容量之间只剩与索引大小有关的开销
+template<typename MultiType>
+double runDrainCost(int capacity, int writes, int rounds) {
+	MultiType origin(capacity), target(capacity);
+	uint64_t version = 0;
+	for (int key = 0; key < capacity; ++key) {
+		origin.put(key, key, ++version);
+	}
+	target.apply(origin.drainChanges());
+
+	double best = 0;
+	for (int round = 0; round < rounds; ++round) {
+		for (int key = 0; key < writes; ++key) {
+			origin.put(key, -key, ++version);
+		}
+		auto start_time = std::chrono::high_resolution_clock::now();
+		target.apply(origin.drainChanges());
+		auto end_time = std::chrono::high_resolution_clock::now();
+		std::chrono::duration<double, std::milli> elapsed = end_time - start_time;
+		best = round == 0 ? elapsed.count() : std::min(best, elapsed.count());
+	}
+	return best;
+}
+
+// 写入量相同时，同步开销不随缓存容量增长：容量相差 50 倍，耗时之比应接近 1
+template<typename MultiType>
+void runDrainCostFlat(const std::string &name) {
+	auto small = runDrainCost<MultiType>(10000, 100, 20);
+	auto large = runDrainCost<MultiType>(500000, 100, 20);
+	std::cout << name << "	100 次写入的同步耗时 capacity 10000: " << small << " ms";
+	std::cout << " | capacity 500000: " << large << " ms | 比值: " << large / small << std::endl;
+	assert(large < small * 3);
+}
+
+void testDrainCostFlat() {
+	std::cout << "\n=== 同步耗时与容量无关 ===\n";
+	runDrainCostFlat<MultiLRU<int, int>>("MultiLRU");
+	runDrainCostFlat<MultiLFU<int, int>>("MultiLFU");
+}
+
+// 同一个同步周期内多个线程写入同一个 key，同步后所有线程都返回最后一次调用写入的值；
+// 每轮按不同的顺序从各线程写入，最后写入的线程每轮不同
+template<typename CacheType>
+void runSyncConflict(const std::string &name, int threadNum, int rounds) {
+	CacheType cache(100, threadNum, 3600);
+	for (int round = 0; round < rounds; ++round) {
+		for (int i = 0; i < threadNum; ++i) {
+			cache.put(7, round * threadNum + i, (round + i) % threadNum);
+		}
+		cache.syncCache();
+		int expected = round * threadNum + threadNum - 1;
+		for (int i = 0; i < threadNum; ++i) {
+			assert(cache.get(7, i) == expected);
+		}
+	}
+	std::cout << name << "\t" << rounds << " 轮冲突写入后各线程的值一致" << std::endl;
+}
+
+void testSyncConflict() {
+	std::cout << "\n=== 同步冲突 ===\n";
+	for (int threadNum : {2, 4}) {
+		runSyncConflict<LRUCache<int, int>>("LRUCache", threadNum, 100);
+		runSyncConflict<LFUCache<int, int>>("LFUCache", threadNum, 100);
+	}
+}
+
+// 调用方线程取得版本号后被抢占，本地写入晚于同步到达：已经同步来的新版本不能被旧写入覆盖，
+// 旧写入也不再记为脏 key，否则本分片留下旧值，而其它分片因版本更新跳过它
+template<typename MultiType>
+void runStalePut(const std::string &name) {
+	MultiType cache(10);
+	cache.apply({{6, 7, 60, std::nullopt}});
+	cache.put(7, 50, 5);
+	assert(cache.get(7) == 60);
+	cache.put(7, 51, std::chrono::seconds(10), 5);
+	assert(cache.get(7) == 60);
+	assert(cache.drainChanges().empty());
+	// 更新的本地写入照常生效
+	cache.put(7, 70, 7);
+	assert(cache.get(7) == 70);
+	assert(cache.drainChanges().size() == 1);
+	std::cout << name << "\t晚到的旧版本写入不覆盖已同步的新版本" << std::endl;
+}
+
+void testStalePut() {
+	std::cout << "\n=== 晚到的旧写入 ===\n";
+	runStalePut<MultiLRU<int, int>>("MultiLRU");
+	runStalePut<MultiLFU<int, int>>("MultiLFU");
+}
+
+// 写入远多于容量的 key 后，常驻条目数正好等于总容量：各分片容量之和不超出，分片数不超过容量
+template<typename CacheType, typename... Args>
+void runShardCapacity(const std::string &name, size_t capacity, size_t shardNum, Args... args) {
+	CacheType cache(capacity, shardNum, args...);
+	assert(cache.shardNum() <= std::max<size_t>(capacity, 1));
+	int keys = static_cast<int>(capacity) * 100 + 100;
+	for (int key = 0; key < keys; ++key) {
+		cache.put(key, key);
+	}
+	size_t resident = 0;
+	for (int key = 0; key < keys; ++key) {
+		resident += cache.get(key) != std::nullopt;
+	}
+	assert(resident == capacity);
+	std::cout << name << "\tcapacity " << capacity << " 分片数 " << cache.shardNum() << " 常驻条目数 " << resident << std::endl;
+}
+
+void testShardCapacity() {
+	std::cout << "\n=== 分片容量 ===\n";
+	for (size_t capacity : {1, 10, 100, 1000}) {
+		runShardCapacity<ShardedLRU<int, int>>("分片 LRU", capacity, 64);
+		runShardCapacity<ShardedArcCache<int, int>>("分片 ARC", capacity, 64, 2);
+	}
+}
+
+int main() {
+	for (int threadNum : {1, 4, 16, 32}) {
+		testShardedLRU(100000, threadNum, 200000);
+	}
+	for (int threadNum : {1, 4, 16, 32}) {
+		testShardedArc(100000, threadNum, 200000);
+	}
+	for (int threadNum : {1, 4, 16}) {
+		testFifoThroughput(100000, threadNum, 200000);
+	}
+	testLockFreeRead();
+	testMultiGet(10000, 50, 2000);
+	testMultiGet(10000, 200, 500);
+	testAsyncGet(10000, 100000);
+	testReentrantCallback();
+	testPostScaling(640000);
+	testSyncCost(4);
+	testDrainAfterPrune();
+	testDrainCostFlat();
+	testSyncConflict();
+	testStalePut();
+	testShardCapacity();
+	return 0;
+}
@@ -0,0 +1,135 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include "LRU.h"
+#include "LFU.h"
+#include "LRUCache.h"
+#include "LFUCache.h"
+#include "ArcCache.h"
+
+using namespace Cache;
+using namespace std::chrono_literals;
+
+// 过期前命中，过期后未命中；不带过期时间的 put 会清除原来的过期时间
+template<typename CacheType>
+void testExpire(const std::string &name, CacheType &cache) {
+	cache.put(1, "short", 20ms);
+	cache.put(2, "long", 10s);
+	cache.put(3, "forever");
+	cache.put(4, "reset", 20ms);
+	cache.put(4, "reset");    // 清除过期时间
+	assert(cache.get(1) != std::nullopt);
+	assert(cache.expiringSize() == 2);
+
+	std::this_thread::sleep_for(40ms);
+	assert(cache.peek(1) == std::nullopt);    // 只读访问也看不到过期条目
+	assert(cache.get(1) == std::nullopt);
+	assert(cache.get(2) != std::nullopt);
+	assert(cache.get(3) != std::nullopt);
+	assert(cache.get(4) != std::nullopt);
+	assert(cache.size() == 3);
+	assert(cache.expiringSize() == 1);
+
+	// 重新设置过期时间以最后一次为准
+	cache.put(2, "long", 20ms);
+	std::this_thread::sleep_for(40ms);
+	assert(cache.get(2) == std::nullopt);
+	assert(cache.expiringSize() == 0);
+	std::cout << name << "\t过期前命中、过期后未命中，剩余条目数: " << cache.size() << std::endl;
+}
+
+// ArcCache 过期的条目直接删除，不进入淘汰链表；过期时间再长也不会溢出
+void testArcExpire() {
+	ArcCache<int, std::string> cache(100, 2);
+	cache.put(1, "short", 20ms);
+	cache.put(2, "max", std::chrono::nanoseconds::max());
+	cache.put(3, "forever");
+	cache.put(4, "reset", 20ms);
+	cache.put(4, "reset");    // 清除过期时间
+	assert(cache.get(1) != std::nullopt);    // 命中后进入 LFU 部分，过期时间不变
+	assert(cache.expiringSize() == 2);
+
+	std::this_thread::sleep_for(40ms);
+	assert(cache.get(1) == std::nullopt);
+	assert(cache.get(2) != std::nullopt);
+	assert(cache.get(3) != std::nullopt);
+	assert(cache.get(4) != std::nullopt);
+	assert(cache.totalWeight() == 3 && cache.ghostWeight() == 0);
+	assert(cache.expiringSize() == 1);
+	std::cout << "ARC\t过期前命中、过期后未命中，剩余条目数: " << cache.totalWeight() << std::endl;
+}
+
+// 多线程缓存：同步时带上剩余的过期时间，其它线程中的副本同时过期
+template<typename CacheType>
+void testSyncExpire(const std::string &name) {
+	CacheType cache(100, 2, 3600);
+	cache.put(1, "short", 50ms, 0);
+	cache.put(2, "forever", 0);
+	cache.syncCache();
+	assert(cache.get(1, 1) != std::nullopt);
+	assert(cache.get(2, 1) != std::nullopt);
+
+	std::this_thread::sleep_for(80ms);
+	assert(cache.get(1, 0) == std::nullopt);
+	assert(cache.get(1, 1) == std::nullopt);
+	assert(cache.get(2, 1) != std::nullopt);
+	std::cout << name << "\t同步后的副本与原条目同时过期" << std::endl;
+}
+
+// 大量随机过期时间的条目，由之后的普通写入回收，不需要扫描
+template<typename CacheType>
+void testReclaim(const std::string &name, CacheType &cache, int count) {
+	std::mt19937 gen(42);
+	for (int key = 0; key < count; ++key) {
+		cache.put(key, "value", std::chrono::milliseconds(1 + gen() % 100));
+	}
+	// 写入过程中先到期的条目已经被后续的 put 回收
+	assert(cache.size() <= static_cast<size_t>(count) && cache.size() == cache.expiringSize());
+	std::this_thread::sleep_for(120ms);
+
+	// 命中路径不推进时间轮，一次普通写入推进并回收全部过期条目
+	auto start = std::chrono::steady_clock::now();
+	cache.put(count, "value");
+	auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	assert(cache.size() == 1 && cache.expiringSize() == 0);
+	std::cout << name << "\t" << count << " 个条目全部过期，回收耗时: " << elapsed.count() << " us" << std::endl;
+}
+
+// 只读负载下，未命中按采样节奏推进时间轮，过期条目最终也会被回收
+template<typename CacheType>
+void testSampledReclaim(const std::string &name, CacheType &cache) {
+	for (int key = 0; key < 100; ++key) {
+		cache.put(key, "value", 10ms);
+	}
+	std::this_thread::sleep_for(30ms);
+	for (int key = 100; key < 100 + 64; ++key) {
+		assert(cache.get(key) == std::nullopt);
+	}
+	assert(cache.size() == 0 && cache.expiringSize() == 0);
+	std::cout << name << "\t只读负载下过期条目由未命中的 get 回收" << std::endl;
+}
+
+int main() {
+	std::cout << "=== 条目过期 ===" << std::endl;
+	LRU<int, std::string> lru(100);
+	testExpire("LRU", lru);
+	LFU<int, std::string> lfu(100);
+	testExpire("LFU", lfu);
+	testArcExpire();
+	testSyncExpire<LRUCache<int, std::string>>("LRUCache");
+	testSyncExpire<LFUCache<int, std::string>>("LFUCache");
+
+	int count = 100000;
+	LRU<int, std::string> bigLru(count);
+	testReclaim("LRU", bigLru, count);
+	LFU<int, std::string> bigLfu(count);
+	testReclaim("LFU", bigLfu, count);
+	LRU<int, std::string> readLru(100);
+	testSampledReclaim("LRU", readLru);
+	LFU<int, std::string> readLfu(100);
+	testSampledReclaim("LFU", readLfu);
+	return 0;
+}
@@ -0,0 +1,217 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include "LRU.h"
+#include "PoolLRU.h"
+#include "LFU.h"
+#include "BucketLFU.h"
+#include "ArcCache.h"
+#include "FlatMap.h"
+
+using namespace std;
+using namespace Cache;
+
+// 统一的访问耗时测试：先写满缓存，再以 80% 命中的随机 key 读取
+double measureGet(CachePolicy<int, int> *cache, int capacity, int operations) {
+	std::mt19937 gen(42);
+	for (int key = 0; key < capacity; ++key) {
+		cache->put(key, key);
+	}
+
+	std::vector<int> keys(operations);
+	for (auto &key : keys) {
+		key = (gen() % 100 < 80) ? gen() % capacity : capacity + gen() % capacity;
+	}
+
+	int hits = 0;
+	auto start_time = std::chrono::high_resolution_clock::now();
+	for (int key : keys) {
+		if (cache->get(key) != std::nullopt) {
+			hits++;
+		} else {
+			cache->put(key, key);
+		}
+	}
+	auto end_time = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<double, std::nano> elapsed = end_time - start_time;
+
+	std::cout << "命中率: " << (100.0 * hits / operations) << "%";
+	std::cout << " | 平均耗时: " << elapsed.count() / operations << " ns/op" << std::endl;
+	return elapsed.count();
+}
+
+// LRU 与节点池化的 PoolLRU 对比
+void testPoolLRU(int capacity, int operations) {
+	std::cout << "\n=== LRU vs PoolLRU ===\n";
+	std::cout << "capacity " << capacity << " operations " << operations << std::endl;
+
+	auto lru = new LRU<int, int>(capacity);
+	std::cout << "LRU     ";
+	auto lruTime = measureGet(lru, capacity, operations);
+	delete lru;
+
+	auto poolLru = new PoolLRU<int, int>(capacity);
+	std::cout << "PoolLRU ";
+	auto poolTime = measureGet(poolLru, capacity, operations);
+	delete poolLru;
+
+	std::cout << "加速比: " << lruTime / poolTime << std::endl;
+}
+
+// LFU 与频率桶链表实现的 BucketLFU 对比
+void testBucketLFU(int capacity, int operations) {
+	std::cout << "\n=== LFU vs BucketLFU ===\n";
+	std::cout << "capacity " << capacity << " operations " << operations << std::endl;
+
+	auto lfu = new LFU<int, int>(capacity);
+	std::cout << "LFU       ";
+	auto lfuTime = measureGet(lfu, capacity, operations);
+	delete lfu;
+
+	auto bucketLfu = new BucketLFU<int, int>(capacity);
+	std::cout << "BucketLFU ";
+	auto bucketTime = measureGet(bucketLfu, capacity, operations);
+	std::cout << "频率桶数量: " << bucketLfu->bucketNum() << std::endl;
+	delete bucketLfu;
+
+	std::cout << "加速比: " << lfuTime / bucketTime << std::endl;
+}
+
+// LFU 频率老化的尾延迟测试：大量新 key 写入会反复触发老化，返回 p99.9（微秒）
+double testLFUAging(int capacity, int operations, int maxAverageNum) {
+	std::cout << "\n=== LFU 老化尾延迟测试 ===\n";
+	std::cout << "capacity " << capacity << " operations " << operations << std::endl;
+
+	LFU<int, int> lfu(capacity, maxAverageNum);
+	std::mt19937 gen(42);
+	std::vector<double> latency;
+	latency.reserve(operations);
+
+	for (int op = 0; op < operations; ++op) {
+		int key = (op % 100 < 50) ? gen() % capacity : op;
+		auto start_time = std::chrono::high_resolution_clock::now();
+		if (lfu.get(key) == std::nullopt) {
+			lfu.put(key, op);
+		}
+		auto end_time = std::chrono::high_resolution_clock::now();
+		latency.push_back(std::chrono::duration<double, std::micro>(end_time - start_time).count());
+	}
+
+	std::sort(latency.begin(), latency.end());
+	std::cout << "p50: " << latency[latency.size() / 2] << " us";
+	std::cout << " | p99: " << latency[latency.size() * 99 / 100] << " us";
+	std::cout << " | p99.9: " << latency[latency.size() * 999 / 1000] << " us";
+	std::cout << " | max: " << latency.back() << " us" << std::endl;
+	return latency[latency.size() * 999 / 1000];
+}
+
+// 老化不再遍历全部节点，尾延迟不随容量增长：容量相差 20 倍，p99.9 之比应接近 1
+void testLFUAgingFlat(int operations, int maxAverageNum) {
+	auto small = testLFUAging(10000, operations, maxAverageNum);
+	auto large = testLFUAging(200000, operations, maxAverageNum);
+	std::cout << "p99.9 比值（200000 / 10000）: " << large / small << std::endl;
+	assert(large < small * 3);
+}
+
+// ArcCache 命中与未命中的平均耗时：命中的 key 一半在 LRU 部分、一半已转移到 LFU 部分，未命中的 key 从未写入过
+void testArcLatency(int capacity, int operations) {
+	ArcCache<int, int> arc(capacity, 2);
+	for (int key = 0; key < capacity; ++key) {
+		arc.put(key, key);
+	}
+	for (int key = 0; key < capacity; key += 2) {
+		arc.get(key);
+	}
+
+	std::mt19937 gen(42);
+	std::vector<int> hitKeys(operations), missKeys(operations);
+	for (int i = 0; i < operations; ++i) {
+		hitKeys[i] = gen() % capacity;
+		missKeys[i] = capacity + gen() % capacity;
+	}
+
+	size_t found = 0;
+	auto start_time = std::chrono::high_resolution_clock::now();
+	for (int key : hitKeys) {
+		found += arc.get(key).value_or(0);
+	}
+	auto mid_time = std::chrono::high_resolution_clock::now();
+	for (int key : missKeys) {
+		found += arc.get(key).value_or(0);
+	}
+	auto end_time = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<double, std::nano> hitTime = mid_time - start_time;
+	std::chrono::duration<double, std::nano> missTime = end_time - mid_time;
+
+	std::cout << "capacity " << capacity;
+	std::cout << " | 命中: " << hitTime.count() / operations << " ns/op";
+	std::cout << " | 未命中: " << missTime.count() / operations << " ns/op (" << found << ")" << std::endl;
+}
+
+// 单次查找耗时，一半命中一半未命中
+template<typename Map>
+double measureLookup(const Map &map, const std::vector<int> &keys) {
+	size_t found = 0;
+	auto start_time = std::chrono::high_resolution_clock::now();
+	for (int key : keys) {
+		auto it = map.find(key);
+		if (it != map.end()) {
+			found += it->second;
+		}
+	}
+	auto end_time = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<double, std::nano> elapsed = end_time - start_time;
+	std::cout << "平均查找耗时: " << elapsed.count() / keys.size() << " ns/op (" << found << ")" << std::endl;
+	return elapsed.count();
+}
+
+// std::unordered_map 与 FlatMap 的索引查找对比
+void testFlatMap(int keyNum) {
+	std::cout << "\n=== unordered_map vs FlatMap ===\n";
+	std::cout << "keys " << keyNum << std::endl;
+
+	std::mt19937 gen(42);
+	std::vector<int> keys(keyNum);
+	for (auto &key : keys) {
+		key = static_cast<int>(gen() % (2u * keyNum));
+	}
+
+	double stdTime, flatTime;
+	{
+		std::unordered_map<int, uint32_t> map;
+		for (int i = 0; i < keyNum; i += 2) {
+			map[i] = i;
+		}
+		std::cout << "unordered_map ";
+		stdTime = measureLookup(map, keys);
+	}
+	{
+		FlatMap<int, uint32_t> map;
+		for (int i = 0; i < keyNum; i += 2) {
+			map[i] = i;
+		}
+		std::cout << "FlatMap       ";
+		flatTime = measureLookup(map, keys);
+	}
+	std::cout << "加速比: " << stdTime / flatTime << std::endl;
+}
+
+int main() {
+	testPoolLRU(10000, 1000000);
+	testPoolLRU(1000000, 2000000);
+	testBucketLFU(10000, 1000000);
+	testLFUAging(10000, 1000000, 10);
+	testLFUAgingFlat(3000000, 2);
+
+	std::cout << "\n=== ArcCache 命中与未命中耗时测试 ===\n";
+	testArcLatency(1000, 1000000);
+	testArcLatency(100000, 1000000);
+	testArcLatency(1000000, 1000000);
+
+	testFlatMap(10000000);
+	return 0;
+}
@@ -0,0 +1,91 @@
+#include <iostream>
+#include <cassert>
+#include <random>
+#include <string>
+#include "LRU.h"
+#include "LFU.h"
+#include "ArcCache.h"
+
+using namespace Cache;
+
+// 按字节计算权重：key 与 value 的长度之和
+struct ByteWeigher {
+	size_t operator()(const int &, const std::string &value) const {
+		return sizeof(int) + value.size();
+	}
+};
+
+// 大小从 40 字节到 64KB 不等的 value
+std::string makeValue(std::mt19937 &gen) {
+	size_t size = (gen() % 100 < 90) ? 40 + gen() % 200 : 4096 + gen() % 61440;
+	return std::string(size, 'v');
+}
+
+// 随机写入不同大小的条目，任何时刻总权重都不超过字节预算
+template<typename CacheType>
+void testBudget(const std::string &name, CacheType &cache, size_t budget, int operations) {
+	std::mt19937 gen(42);
+	size_t maxWeight = 0;
+	int hits = 0;
+	for (int op = 0; op < operations; ++op) {
+		int key = gen() % 5000;
+		if (cache.get(key) != std::nullopt) {
+			hits++;
+		} else {
+			cache.put(key, makeValue(gen));
+		}
+		maxWeight = std::max(maxWeight, cache.totalWeight());
+		assert(cache.totalWeight() <= budget);
+	}
+	std::cout << name << "\t预算: " << budget << " 字节 | 当前: " << cache.totalWeight() << " 字节 | 峰值: " << maxWeight;
+	std::cout << " 字节 | 命中率: " << (100.0 * hits / operations) << "%";
+	std::cout << " | 每条目额外开销: " << cache.nodeOverhead() << " 字节" << std::endl;
+}
+
+// 一个大条目需要连续淘汰多个小条目才能放下；超过预算的条目放不下
+template<typename CacheType>
+void testEvictUntilFits(const std::string &name, CacheType &cache) {
+	for (int key = 0; key < 10; ++key) {
+		cache.put(key, std::string(96, 'v'));    // 每条 100 字节，共 1000 字节
+	}
+	assert(cache.totalWeight() == 1000);
+
+	cache.put(100, std::string(496, 'v'));        // 500 字节，至少淘汰 5 个小条目
+	assert(cache.get(100) != std::nullopt);
+	assert(cache.totalWeight() <= 1000);
+
+	cache.put(200, std::string(2000, 'v'));       // 超过预算，不会放入
+	assert(cache.get(200) == std::nullopt);
+	assert(cache.totalWeight() <= 1000);
+
+	// 已有条目更新为超过预算的值，旧值一并删除
+	cache.put(100, std::string(2000, 'v'));
+	assert(cache.get(100) == std::nullopt);
+	std::cout << name << "\t连续淘汰后权重: " << cache.totalWeight() << " 字节" << std::endl;
+}
+
+int main() {
+	std::cout << "=== 按字节预算淘汰 ===" << std::endl;
+	LRU<int, std::string, ByteWeigher> lru(1000);
+	testEvictUntilFits("LRU", lru);
+	LFU<int, std::string, ByteWeigher> lfu(1000);
+	testEvictUntilFits("LFU", lfu);
+
+	size_t budget = 4 << 20;
+	LRU<int, std::string, ByteWeigher> bigLru(budget);
+	testBudget("LRU", bigLru, budget, 200000);
+	LFU<int, std::string, ByteWeigher> bigLfu(budget);
+	testBudget("LFU", bigLfu, budget, 200000);
+	// ARC 的两部分合计不超过预算，两者之间的划分按命中淘汰链表的条目权重自适应
+	ArcCache<int, std::string, ByteWeigher> arc(budget, 2);
+	testBudget("ARC", arc, budget, 200000);
+
+	// 默认权重为 1，容量即条目数
+	LRU<int, std::string> countLru(100);
+	for (int key = 0; key < 1000; ++key) {
+		countLru.put(key, "value");
+	}
+	assert(countLru.totalWeight() == 100 && countLru.size() == 100);
+	std::cout << "\n默认权重 LRU 条目数: " << countLru.size() << " | 每条目额外开销: " << countLru.nodeOverhead() << " 字节" << std::endl;
+	return 0;
+}